@@ -91,14 +91,11 @@ int main() {
     std::cout << std::endl;
   }
 
-  // Step 3: Find structs/classes with @reflect tag using node's find_descendants
+  // Step 3: Find structs/classes with @reflect tag using a compiled selector
   std::cout << "[2] Finding structs/classes with @reflect tag..." << std::endl;
 
-  auto reflected_records = ast->find_descendants([](const xccmeta::node_ptr& n) {
-    return (n->get_kind() == xccmeta::node::kind::struct_decl ||
-            n->get_kind() == xccmeta::node::kind::class_decl) &&
-           n->has_tag("reflect");
-  });
+  xccmeta::selector reflected("struct[@reflect], class[@reflect]");
+  auto reflected_records = reflected.select(ast).to_vector();
 
   std::cout << "    Found " << reflected_records.size() << " record(s) with @reflect tag" << std::endl;
 
@@ -25,9 +25,18 @@ SOFTWARE.
 #pragma once
 
 #include "xccmeta/xccmeta_base.hpp"
+#include "xccmeta/xccmeta_class_hierarchy.hpp"
+#include "xccmeta/xccmeta_diff.hpp"
 #include "xccmeta/xccmeta_filter.hpp"
 #include "xccmeta/xccmeta_generator.hpp"
 #include "xccmeta/xccmeta_import.hpp"
 #include "xccmeta/xccmeta_parser.hpp"
+#include "xccmeta/xccmeta_pipeline.hpp"
 #include "xccmeta/xccmeta_preprocess.hpp"
+#include "xccmeta/xccmeta_selector.hpp"
+#include "xccmeta/xccmeta_snapshot.hpp"
+#include "xccmeta/xccmeta_subtree_pool.hpp"
+#include "xccmeta/xccmeta_type_graph.hpp"
+#include "xccmeta/xccmeta_usr_registry.hpp"
 #include "xccmeta/xccmeta_warnings.hpp"
+#include "xccmeta/xccmeta_watch.hpp"
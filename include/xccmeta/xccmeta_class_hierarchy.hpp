@@ -0,0 +1,113 @@
+/*
+MIT License
+
+Copyright (c) 2026 Christian Luppi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <unordered_map>
+
+#include "xccmeta_node.hpp"
+
+namespace xccmeta {
+
+  // Inheritance index over the records of one or more parsed trees.
+  //
+  // Classes are matched by USR across trees (definitions preferred) and linked
+  // through their base_specifier nodes. Transitive queries are answered from
+  // preorder intervals over the single-inheritance forest, plus a bitset of
+  // bases for each class that starts a tree while having bases of its own
+  // (multiple inheritance), so derived/base checks never walk the tree or
+  // compare names.
+  class XCCMETA_API class_hierarchy {
+   public:
+    using class_id = std::uint32_t;
+    static constexpr class_id invalid_class = static_cast<class_id>(-1);
+
+    struct base_link {
+      class_id base = invalid_class;
+      bool is_virtual = false;
+      access_specifier access = access_specifier::invalid;
+    };
+
+    class_hierarchy() = default;
+    explicit class_hierarchy(const node_ptr& root);
+    explicit class_hierarchy(const std::vector<node_ptr>& roots);  // e.g. one root per translation unit
+
+    // Classes (structs, classes, unions and class templates)
+    std::size_t size() const;
+    class_id find(const std::string& usr) const;
+    class_id find(const node_ptr& n) const;
+    const node_ptr& get_node(class_id c) const;
+
+    // Direct relations
+    std::span<const base_link> get_bases(class_id c) const;  // In declaration order
+    std::span<const class_id> get_derived(class_id c) const;  // Ascending id
+
+    // Transitive relations
+    bool is_derived_from(class_id derived, class_id base) const;  // O(1), false for derived == base
+    std::vector<class_id> get_all_derived(class_id c) const;      // Ascending id
+    std::vector<class_id> get_all_bases(class_id c) const;        // Ascending id
+
+    // Virtual inheritance: bases shared by every path (virtual bases of c or of any of its bases)
+    bool is_virtual_base_of(class_id base, class_id derived) const;  // O(log v), v virtual bases of derived
+    std::vector<class_id> get_virtual_bases(class_id c) const;       // Ascending id
+
+   private:
+    // Fixed-width bit rows
+    struct bit_matrix {
+      std::size_t words_per_row = 0;
+      std::vector<std::uint64_t> bits;
+
+      void reset(std::size_t rows, std::size_t columns);
+      bool test(std::size_t row, class_id col) const;
+      void set(std::size_t row, class_id col);
+      void merge(std::size_t row, std::size_t from);  // row |= from
+      std::vector<class_id> row_members(std::size_t row) const;
+    };
+
+    static constexpr std::uint32_t no_row = static_cast<std::uint32_t>(-1);
+
+    void build(const std::vector<node_ptr>& roots);
+    bool in_subtree(class_id c, class_id root) const;  // c strictly below root in the forest
+
+    std::vector<node_ptr> nodes_;
+    std::unordered_map<std::string, class_id> by_usr_;
+    std::vector<std::vector<base_link>> bases_;
+    std::vector<std::vector<class_id>> derived_;
+
+    // Forest in which a class with exactly one base hangs under it. Classes with
+    // no base, or several, start their own tree, so every class's bases are its
+    // forest ancestors plus the bases of its tree root.
+    std::vector<class_id> tree_parent_;        // invalid_class for tree roots
+    std::vector<class_id> tree_root_;
+    std::vector<std::uint32_t> preorder_;      // Position of each class in forest preorder
+    std::vector<std::uint32_t> subtree_end_;   // One past the last position of its subtree
+    std::vector<class_id> by_preorder_;
+    std::vector<class_id> based_roots_;        // Tree roots with bases, one bit row each
+    std::vector<std::uint32_t> root_row_;      // Row of a class in root_bases_, or no_row
+    bit_matrix root_bases_;                    // All transitive bases of each based root
+
+    std::vector<std::vector<class_id>> virtual_bases_;  // Sorted, per class
+  };
+
+}  // namespace xccmeta
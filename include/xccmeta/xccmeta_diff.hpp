@@ -0,0 +1,87 @@
+/*
+MIT License
+
+Copyright (c) 2026 Christian Luppi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "xccmeta_node.hpp"
+
+namespace xccmeta {
+
+  // Attribute groups reported by diff(); combined into a change mask
+  enum class change : std::uint32_t {
+    none = 0,
+    kind = 1u << 0,
+    name = 1u << 1,      // Name, qualified, display or mangled name
+    type = 1u << 2,      // Type or return type
+    access = 1u << 3,    // Access specifier or storage class
+    flags = 1u << 4,     // Boolean declaration properties (virtual, static, definition, ...)
+    value = 1u << 5,     // Default value, enum value, underlying type, bitfield width
+    comment = 1u << 6,   // Raw or brief comment
+    tags = 1u << 7,      // Own tags or their arguments
+    location = 1u << 8,  // Location or extent (only with diff_options::include_locations)
+    children = 1u << 9,  // Direct children added, removed or reordered
+  };
+
+  using change_mask = std::uint32_t;
+
+  constexpr change_mask operator|(change a, change b) {
+    return static_cast<change_mask>(a) | static_cast<change_mask>(b);
+  }
+  constexpr change_mask operator|(change_mask a, change b) {
+    return a | static_cast<change_mask>(b);
+  }
+  constexpr bool has_change(change_mask mask, change c) {
+    return (mask & static_cast<change_mask>(c)) != 0;
+  }
+
+  struct XCCMETA_API diff_options {
+    bool include_locations = false;  // Report moved declarations as changed
+  };
+
+  // One step of the edit script
+  struct XCCMETA_API diff_entry {
+    enum class operation {
+      added,    // new_node was added (with its subtree)
+      removed,  // old_node was removed (with its subtree)
+      changed,  // old_node / new_node match; see changes
+    };
+
+    operation op = operation::changed;
+    node_ptr old_node;
+    node_ptr new_node;
+    change_mask changes = 0;
+  };
+
+  // Compare two parses of the same inputs.
+  //
+  // Children are matched among siblings by USR, falling back to kind and
+  // qualified name (then display name) for declarations without one; repeated
+  // keys pair up in source order. Matched subtrees with equal structural hashes
+  // (node::get_hash) are skipped without visiting them. Entries are in preorder
+  // of the old tree, with added nodes after the removed and changed siblings
+  // of their parent.
+  XCCMETA_API std::vector<diff_entry> diff(const node_ptr& old_root, const node_ptr& new_root, const diff_options& options);
+  XCCMETA_API std::vector<diff_entry> diff(const node_ptr& old_root, const node_ptr& new_root);
+
+}  // namespace xccmeta
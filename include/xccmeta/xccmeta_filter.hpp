@@ -24,6 +24,10 @@ SOFTWARE.
 
 #pragma once
 
+#include <algorithm>
+#include <iterator>
+#include <string_view>
+
 #include "xccmeta_node.hpp"
 
 namespace xccmeta {
@@ -48,12 +52,93 @@ namespace xccmeta {
       // If a node has a tag name in this list, it will be excluded
       std::vector<std::string> avoid_tag_names;
 
+      // Glob patterns on the qualified name, matched segment by segment ("::"):
+      //   *   any characters within one segment      ?  any single character
+      //   **  as a whole segment, zero or more segments
+      // e.g. "engine::**::components::*" or "**::detail::**"
+      // If not empty, a node must match one of name_patterns
+      std::vector<std::string> name_patterns;
+
+      // A node matching any of these patterns is excluded
+      std::vector<std::string> avoid_name_patterns;
+
       // Whether to include nodes into the list even if they dont have tags
       // These still dont't bypass ALLOWED_KINDS filtering but they do bypass tag name filtering
+      // (avoid_tag_names and avoid_name_patterns still apply, name_patterns does not)
       node_inclusion child_node_inclusion = node_inclusion::exclude;
       node_inclusion parent_node_inclusion = node_inclusion::exclude;
     };
 
+    // Read-only view of the types in insertion order. Entries blanked by remove()
+    // and not yet compacted away are skipped; the view is invalidated by any
+    // change to the filter.
+    class XCCMETA_API type_range {
+     public:
+      class iterator {
+       public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = node_ptr;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const node_ptr*;
+        using reference = const node_ptr&;
+
+        iterator() = default;
+
+        reference operator*() const { return *it_; }
+        pointer operator->() const { return &*it_; }
+
+        iterator& operator++() {
+          do ++it_;
+          while (it_ != end_ && !*it_);
+          return *this;
+        }
+        iterator operator++(int) {
+          iterator old = *this;
+          ++*this;
+          return old;
+        }
+        iterator& operator--() {
+          do --it_;
+          while (!*it_);
+          return *this;
+        }
+        iterator operator--(int) {
+          iterator old = *this;
+          --*this;
+          return old;
+        }
+
+        bool operator==(const iterator& other) const { return it_ == other.it_; }
+
+       private:
+        friend class type_range;
+        using base = std::vector<node_ptr>::const_iterator;
+        iterator(base it, base end): it_(it), end_(end) {
+          while (it_ != end_ && !*it_) ++it_;
+        }
+
+        base it_ {};
+        base end_ {};
+      };
+
+      type_range(const std::vector<node_ptr>& types, std::size_t live): types_(&types), live_(live) {}
+
+      iterator begin() const { return iterator(types_->begin(), types_->end()); }
+      iterator end() const { return iterator(types_->end(), types_->end()); }
+      std::size_t size() const { return live_; }
+      bool empty() const { return live_ == 0; }
+      const node_ptr& front() const { return *begin(); }
+      const node_ptr& back() const { return *std::prev(end()); }
+
+      bool operator==(const type_range& other) const {
+        return size() == other.size() && std::equal(begin(), end(), other.begin());
+      }
+
+     private:
+      const std::vector<node_ptr>* types_;
+      std::size_t live_;
+    };
+
     filter(const config& cfg = config {});
 
     // Go over all types and remove any that don't meet the criteria
@@ -65,12 +150,27 @@ namespace xccmeta {
     // Add a type to the list (returns true if added, false if already exists or invalid)
     bool add(const node_ptr& type);
 
+    // Add every matching type declaration of a tree in one traversal, honoring
+    // child_node_inclusion / parent_node_inclusion. Top-level subtrees are split
+    // across thread_count threads (0 = hardware concurrency); results are merged
+    // in preorder, so the outcome does not depend on the thread count.
+    // Returns the number of types added.
+    std::size_t add_tree(const node_ptr& root, unsigned thread_count = 1);
+
     // Remove a type from the list (returns true if removed, false if not found)
     bool remove(const node_ptr& type);
 
     // Clear all types from the list
     filter& clear();
 
+    // Set algebra by USR, in place and linear in the size of both lists. Kept
+    // types stay in their order; types taken from other follow in other's order.
+    // The config of neither list is applied.
+    filter& unite(const filter& other);                 // this | other
+    filter& intersect(const filter& other);             // this & other
+    filter& subtract(const filter& other);              // this - other
+    filter& symmetric_difference(const filter& other);  // (this - other) | (other - this)
+
     // Get the number of types in the list
     std::size_t size() const;
 
@@ -78,7 +178,7 @@ namespace xccmeta {
     bool empty() const;
 
     // Get all types in the list
-    const std::vector<node_ptr>& get_types() const;
+    type_range get_types() const;
 
     // Get the current configuration
     const config& get_config() const;
@@ -89,21 +189,89 @@ namespace xccmeta {
     // Check if type matches the config criteria
     bool matches_config(const node_ptr& type) const;
 
+    // matches_config() for every node of a span; result[i] is the answer for types[i]
+    std::vector<bool> matches_many(std::span<const node_ptr> types) const;
+
     // Iterator support
-    auto begin() { return types_.begin(); }
-    auto end() { return types_.end(); }
-    auto begin() const { return types_.begin(); }
-    auto end() const { return types_.end(); }
-    auto cbegin() const { return types_.cbegin(); }
-    auto cend() const { return types_.cend(); }
+    auto begin() { return get_types().begin(); }
+    auto end() { return get_types().end(); }
+    auto begin() const { return get_types().begin(); }
+    auto end() const { return get_types().end(); }
+    auto cbegin() const { return get_types().begin(); }
+    auto cend() const { return get_types().end(); }
 
    private:
-    // Find a type by USR, returns iterator
-    std::vector<node_ptr>::iterator find_by_usr(const std::string& usr);
-    std::vector<node_ptr>::const_iterator find_by_usr(const std::string& usr) const;
+    // add_tree() result entry, ordered by (group, order)
+    struct tree_candidate {
+      std::size_t group;  // 0 for the root, i + 1 for the root's i-th child subtree
+      std::size_t order;  // Preorder position within the group
+      node_ptr node;
+    };
+
+    void collect_subtree(const node_ptr& root, bool root_matched, std::size_t group, const node_ptr& subtree,
+                         std::vector<tree_candidate>& out) const;
+    bool matches(const node& type) const;                // matches_config() without the null check
+    bool matches_inclusion(const node_ptr& type) const;  // Rules for nodes pulled in by inclusion modes
+    bool insert(const node_ptr& type);                   // Add without config checks
+    template <typename Pred>
+    void retain_if(Pred pred);  // Keep the types pred accepts, in order
+
+    // Open-addressing (linear probing) index from USR to position in types_
+    struct index_slot {
+      std::uint64_t hash = 0;
+      std::uint32_t position = 0;
+    };
+    static constexpr std::uint32_t empty_slot = static_cast<std::uint32_t>(-1);
+    static constexpr std::uint32_t deleted_slot = static_cast<std::uint32_t>(-2);
+    static constexpr std::size_t no_slot = static_cast<std::size_t>(-1);
 
+    static std::uint64_t hash_usr(const std::string& usr);
+    std::size_t find_slot(const std::string& usr, std::uint64_t hash) const;  // no_slot if absent
+    void insert_slot(std::uint64_t hash, std::uint32_t position);  // Caller ensures a free slot
+    void rebuild_index();
+    void compact();  // Drop removed entries from types_
+
+    // Removed entries stay null until remove() finds that they make up half of
+    // types_ and compacts, which keeps remove() amortized O(1) while iteration
+    // order stays insertion order. Const access never modifies the filter.
     std::vector<node_ptr> types_;
+    std::vector<index_slot> index_;
+    std::size_t used_slots_ = 0;  // Live and deleted slots
+    std::size_t removed_ = 0;     // Null entries in types_
     config config_;
+
+    // Config compiled at construction: a bit per allowed node::kind, and each tag
+    // name list as a bloom mask plus a bitmap indexed by interned tag id
+    using tag_set = std::vector<std::uint64_t>;
+    static void add_to_set(tag_set& set, tag_id id);
+    static bool has_tag_in(const node& type, const tag_set& set);
+
+    // Name patterns compiled into a trie of segment globs sharing common prefixes.
+    // Matching walks the trie over string_views of the name and never allocates.
+    class name_trie {
+     public:
+      void add(std::string_view pattern);
+      bool empty() const { return states_.size() <= 1; }
+      bool matches(std::string_view qualified_name) const;
+
+     private:
+      struct state {
+        std::string segment;        // Glob for one segment (unused for the root)
+        bool any_segments = false;  // "**"
+        bool accept = false;        // A pattern ends here
+        std::vector<std::uint32_t> next;
+      };
+      bool matches_from(std::uint32_t s, std::string_view rest, bool more) const;
+      std::vector<state> states_ {state {}};
+    };
+
+    std::uint64_t kind_mask_ = ~std::uint64_t {0};
+    name_trie name_patterns_;
+    name_trie avoid_name_patterns_;
+    tag_set grab_tags_;
+    tag_set avoid_tags_;
+    std::uint64_t grab_tag_mask_ = 0;
+    std::uint64_t avoid_tag_mask_ = 0;
   };
 
 }  // namespace xccmeta
\ No newline at end of file
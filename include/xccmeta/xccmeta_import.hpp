@@ -26,14 +26,47 @@ SOFTWARE.
 
 #include "xccmeta_base.hpp"
 
+#include <cstdint>
 #include <filesystem>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace xccmeta {
 
   using path = std::filesystem::path;
 
+  // Read-only view of a whole file's content, memory-mapped where possible and
+  // read into an owned buffer otherwise. The view stays valid until the
+  // mapped_file is destroyed or assigned to.
+  class XCCMETA_API mapped_file {
+   public:
+    mapped_file() = default;
+    ~mapped_file();
+
+    mapped_file(mapped_file&& other) noexcept;
+    mapped_file& operator=(mapped_file&& other) noexcept;
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    bool is_valid() const;   // The file could be opened and read
+    bool is_mapped() const;  // Backed by a memory mapping (not a copy)
+
+    std::string_view view() const;
+    const char* data() const;
+    std::size_t size() const;
+
+   private:
+    friend class file;
+    void release();
+
+    const char* content = nullptr;
+    std::size_t length = 0;
+    bool valid = false;
+    bool mapped = false;
+    std::string buffer;  // Fallback storage when not mapped
+  };
+
   // File class to represent a single file.
   // Its just a wrapper around std::filesystem::path.
   class XCCMETA_API file {
@@ -43,21 +76,129 @@ namespace xccmeta {
 
     bool exists() const;
     std::string read() const;
+    mapped_file map() const;  // read() without copying (see mapped_file)
     bool write(const std::string& content) const;
 
    private:
     path file_path;
   };
 
+  // Shell-style path pattern, compiled once and matched segment by segment on '/':
+  //   *      any characters within one segment     ?  any single character
+  //   [abc]  [a-z]  [!a-z]  character classes (^ also negates)
+  //   **     as a whole segment, zero or more directories
+  // Patterns are anchored: "src/*.cpp" matches "src/a.cpp" but not "lib/src/a.cpp".
+  class XCCMETA_API glob {
+   public:
+    explicit glob(std::string_view pattern);
+
+    bool matches(const path& p) const;
+    bool may_match_below(const path& dir) const;   // Some path inside dir could match
+    bool matches_all_below(const path& dir) const;  // Every path inside dir matches (pattern ends in "**")
+
+    const path& get_base() const;  // Leading directories without wildcards ("" for the current directory)
+    bool is_literal() const;       // No wildcards at all
+
+   private:
+    struct segment {
+      std::string text;
+      bool any_directories = false;  // "**"
+      bool literal = false;
+    };
+
+    bool match_from(std::size_t index, std::string_view rest, bool more, bool prefix) const;
+
+    std::vector<segment> segments;
+    path base;
+    bool literal = true;
+  };
+
+  // Snapshot of a set of files (size, modification time, inode and content hash),
+  // saved to a small binary file so a later run can tell which inputs changed.
+  // Entries are sorted by path.
+  class XCCMETA_API manifest {
+   public:
+    struct entry {
+      path file_path;
+      std::uint64_t size = 0;
+      std::int64_t mtime = 0;   // Nanoseconds since the platform's file time epoch
+      std::uint64_t inode = 0;  // 0 where the platform has none
+      std::uint64_t hash = 0;   // hash_content() of the file's bytes
+    };
+
+    struct changes {
+      std::vector<file> changed;  // Present in both, content differs
+      std::vector<file> added;    // Not in the previous manifest
+      std::vector<path> removed;  // Only in the previous manifest
+
+      bool empty() const;
+    };
+
+    // Stats every file and hashes its content on thread_count threads (0 = hardware
+    // concurrency). Files whose size, mtime and inode match their entry in previous
+    // reuse its hash without being read. Files that cannot be read are left out.
+    static manifest scan(const std::vector<file>& files, const manifest* previous = nullptr,
+                         unsigned thread_count = 1);
+
+    // Fast non-cryptographic 64-bit hash, stable across runs and platforms
+    static std::uint64_t hash_content(std::string_view content);
+
+    bool load(const path& manifest_path);  // False (and empty) if missing or malformed
+    bool save(const path& manifest_path) const;
+
+    changes diff(const manifest& previous) const;
+
+    manifest select(const std::vector<file>& files) const;  // Only the entries of files
+    void merge(const manifest& other);                      // Adds other's entries; they win on equal paths
+
+    const std::vector<entry>& get_entries() const;
+    const entry* find(const path& file_path) const;
+
+   private:
+    std::vector<entry> entries;
+  };
+
   // Importer class to import multiple files based on a wildcard.
   // By passing in a direct filepath, it will import that single file.
+  // Files are returned sorted by path, without duplicates.
   class XCCMETA_API importer {
    public:
+    struct config {
+      // Glob patterns of files to import (see glob)
+      std::vector<std::string> patterns;
+
+      // Files matching any of these are skipped; a pattern ending in "**" also
+      // stops the walk from entering the directories it covers
+      std::vector<std::string> exclude_patterns;
+
+      // Directories are listed, and files hashed, by this many threads (0 = hardware concurrency)
+      unsigned thread_count = 1;
+
+      // When set, the imported files are compared against the manifest a previous
+      // run saved here (see get_changes() and save_manifest())
+      path manifest_path;
+
+      // With a manifest_path, get_files() returns only changed and added files
+      bool only_changed = false;
+    };
+
     explicit importer(const std::string& wildcard);
+    explicit importer(const config& cfg);
     const std::vector<file>& get_files() const;
 
+    // Empty unless config::manifest_path is set
+    const manifest& get_manifest() const;
+    const manifest::changes& get_changes() const;
+
+    // Stores the current manifest at config::manifest_path; call once downstream
+    // stages have consumed the changes, so a failed run is retried next time
+    bool save_manifest() const;
+
    private:
     std::vector<file> files;
+    manifest current;
+    manifest::changes changes;
+    path manifest_path;
   };
 
 }  // namespace xccmeta
\ No newline at end of file
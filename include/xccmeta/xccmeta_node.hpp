@@ -24,6 +24,8 @@ SOFTWARE.
 
 #pragma once
 
+#include <span>
+
 #include "xccmeta_base.hpp"
 #include "xccmeta_source.hpp"
 #include "xccmeta_tags.hpp"
@@ -58,6 +60,7 @@ namespace xccmeta {
   class XCCMETA_API node : public std::enable_shared_from_this<node> {
     friend class parser;
     friend class parser_impl;
+    friend class subtree_pool;
     friend class type_info;
 
     // Private key for passkey idiom - allows make_shared while keeping constructors effectively private
@@ -165,6 +168,11 @@ namespace xccmeta {
     const type_info& get_type() const { return type_; }
     const type_info& get_return_type() const { return return_type_; }  // Return type (for functions/methods)
 
+    // Declaration node of get_type() / get_return_type() (see type_info::get_declaration_usr),
+    // linked by the parser. Null for builtins or types declared outside the tree.
+    node_ptr get_type_declaration() const { return type_decl_.lock(); }
+    node_ptr get_return_type_declaration() const { return return_type_decl_.lock(); }
+
     // Access and storage
     access_specifier get_access() const { return access_; }
     storage_class get_storage_class() const { return storage_class_; }
@@ -210,14 +218,24 @@ namespace xccmeta {
 
     // xccmeta tags (metadata annotations)
     const std::vector<tag>& get_tags() const { return tags_; }
+    std::uint64_t get_tag_mask() const { return tag_mask_; }  // Bloom mask of own tag ids (see tag::mask_of)
     bool has_tag(const std::string& name) const;
+    bool has_tag(tag_id id) const;
     bool has_tags(const std::vector<std::string>& names) const;  // Returns true if any of the tags are present
+    bool has_tag_ids(const std::vector<tag_id>& ids) const;     // Returns true if any of the interned ids are present
     std::optional<tag> find_tag(const std::string& name) const;
+    std::optional<tag> find_tag(tag_id id) const;
     std::vector<tag> find_tags(const std::vector<std::string>& names) const;  // Find all tags matching any of the given names
 
+    // Structural hash of this node's attributes and its whole subtree. Stable across
+    // runs and platforms; computed bottom-up by the parser (0 until then).
+    std::uint64_t get_hash() const { return hash_; }                                // Source positions excluded
+    std::uint64_t get_hash_with_locations() const { return located_hash_; }        // Source positions included
+
     // Tree structure
-    node_ptr get_parent() const { return parent_.lock(); }
+    node_ptr get_parent() const { return parent_.lock(); }  // nullptr for shared nodes (use node_path)
     const std::vector<node_ptr>& get_children() const { return children_; }
+    bool is_shared() const { return shared_; }  // Held by several trees (see subtree_pool); do not modify
 
     // Find first child matching predicate
     template <typename Predicate>
@@ -266,15 +284,26 @@ namespace xccmeta {
     std::vector<tag> get_parent_tags() const;  // Get all tags from parent nodes (walking up the tree)
     std::vector<tag> get_all_tags() const;     // Get all tags (own tags + parent tags combined)
 
+    // Non-copying parent tag views (same order as above).
+    // Computed on first use and memoized per node; siblings share their parent's
+    // storage. The cache is rebuilt when tags or parent links change. Memoization
+    // is not synchronized, warm it up before sharing the tree across threads.
+    std::span<const tag> get_parent_tags_view() const;
+    std::span<const tag> get_all_tags_view() const;
+
     // Convenience queries
     bool is_type_decl() const;                         // Is this a type declaration (class/struct/union/enum/typedef)?
     bool is_record_decl() const;                       // Is this a record type (class/struct/union)?
     bool is_callable() const;                          // Is this a callable (function/method/constructor)?
-    std::vector<node_ptr> get_bases() const;           // Get all base classes (for class/struct)
-    std::vector<node_ptr> get_methods() const;         // Get all methods (for class/struct)
-    std::vector<node_ptr> get_fields() const;          // Get all fields (for class/struct)
-    std::vector<node_ptr> get_parameters() const;      // Get all parameters (for functions/methods)
-    std::vector<node_ptr> get_enum_constants() const;  // Get all enum constants (for enums)
+
+    // Typed child views. Children are grouped by kind as they are added, so these
+    // return contiguous, source-ordered ranges without allocating. Views are
+    // invalidated when children are added or removed.
+    std::span<const node_ptr> get_bases() const;           // Get all base classes (for class/struct)
+    std::span<const node_ptr> get_methods() const;         // Get all methods, constructors, destructors and conversions (for class/struct)
+    std::span<const node_ptr> get_fields() const;          // Get all fields (for class/struct)
+    std::span<const node_ptr> get_parameters() const;      // Get all parameters (for functions/methods)
+    std::span<const node_ptr> get_enum_constants() const;  // Get all enum constants (for enums)
 
    protected:
     // Protected factory method (only accessible by parser)
@@ -294,6 +323,8 @@ namespace xccmeta {
     void set_type(const type_info& t) { type_ = t; }
     type_info& get_return_type_mutable() { return return_type_; }
     void set_return_type(const type_info& t) { return_type_ = t; }
+    void set_type_declaration(const node_ptr& n) { type_decl_ = n; }
+    void set_return_type_declaration(const node_ptr& n) { return_type_decl_ = n; }
 
     void set_access(access_specifier a) { access_ = a; }
     void set_storage_class(storage_class sc) { storage_class_ = sc; }
@@ -326,16 +357,41 @@ namespace xccmeta {
     void set_comment(const std::string& c) { comment_ = c; }
     void set_brief_comment(const std::string& c) { brief_comment_ = c; }
 
-    std::vector<tag>& get_tags_mutable() { return tags_; }
-    void add_tag(const tag& t) { tags_.push_back(t); }
-    void add_tag(tag&& t) { tags_.push_back(std::move(t)); }
+    void add_tag(const tag& t) {
+      tag_mask_ |= tag::mask_of(t.get_id());
+      tags_.push_back(t);
+      invalidate_tag_cache();
+    }
+    void add_tag(tag&& t) {
+      tag_mask_ |= tag::mask_of(t.get_id());
+      tags_.push_back(std::move(t));
+      invalidate_tag_cache();
+    }
 
-    void set_parent(node_ptr p) { parent_ = p; }
-    std::vector<node_ptr>& get_children_mutable() { return children_; }
+    void set_parent(node_ptr p) {
+      parent_ = p;
+      invalidate_tag_cache();
+    }
     void add_child(node_ptr child);
+    void add_children(std::vector<node_ptr> children);  // add_child() for many, rebuilding the kind index once
     void remove_child(const node_ptr& child);
+    // Replace a child by one of the same kind that other trees hold too. The first
+    // time child is shared its inherited tags are pinned and its parent link dropped.
+    void share_child(std::size_t index, node_ptr child);
+    std::vector<node_ptr> release_children();  // Detach and return all children, in order
+
+    void update_hashes();  // Recompute get_hash() / get_hash_with_locations() for this subtree
 
    private:
+    using tag_list_ptr = std::shared_ptr<const std::vector<tag>>;
+
+    // Kind bucket used to order children_by_kind_ (all method-like kinds share one)
+    static int kind_bucket(kind k);
+    std::span<const node_ptr> get_children_in_bucket(kind k) const;
+
+    void build_tag_cache() const;
+    void invalidate_tag_cache();
+
     template <typename Predicate>
     void find_descendants_impl(Predicate pred, std::vector<node_ptr>& result) const {
       for (const auto& child : children_) {
@@ -361,6 +417,8 @@ namespace xccmeta {
     // Type info
     type_info type_;
     type_info return_type_;
+    node_weak_ptr type_decl_;
+    node_weak_ptr return_type_decl_;
 
     // Access and storage
     access_specifier access_ = access_specifier::invalid;
@@ -401,10 +459,21 @@ namespace xccmeta {
 
     // Tags
     std::vector<tag> tags_;
+    std::uint64_t tag_mask_ = 0;
+
+    // Subtree hashes (see get_hash)
+    std::uint64_t hash_ = 0;
+    std::uint64_t located_hash_ = 0;
+
+    // Memoized inherited tags (see get_parent_tags_view)
+    mutable tag_list_ptr parent_tags_cache_;
+    mutable tag_list_ptr all_tags_cache_;
 
     // Tree structure
     node_weak_ptr parent_;
+    bool shared_ = false;
     std::vector<node_ptr> children_;
+    std::vector<node_ptr> children_by_kind_;  // Same children, stably sorted by kind_bucket()
   };
 
   // Utility: Convert enum to string and vice versa
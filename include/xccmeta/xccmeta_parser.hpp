@@ -24,8 +24,11 @@ SOFTWARE.
 
 #pragma once
 
+#include <string_view>
+
 #include "xccmeta_compile_args.hpp"
 #include "xccmeta_node.hpp"
+#include "xccmeta_usr_registry.hpp"
 
 namespace xccmeta {
 
@@ -58,11 +61,25 @@ namespace xccmeta {
     // Move assignment
     parser& operator=(parser&&) noexcept = default;
 
-    // Parse input source code with given compile arguments
-    std::shared_ptr<node> parse(const std::string& input, const compile_args& args);
+    // Parse input source code with given compile arguments. The input is only
+    // read during the call, so a view of a mapped file (file::map()) works without a copy.
+    std::shared_ptr<node> parse(std::string_view input, const compile_args& args);
+
+    // Parse, skipping namespace-scope declarations (with their subtrees) that a parse
+    // sharing the registry already built. The registry may be used by parsers on
+    // other threads at the same time; merge the resulting roots to get every declaration.
+    std::shared_ptr<node> parse(std::string_view input, const compile_args& args, usr_registry& registry);
 
     // Merge two AST nodes (e.g., from multiple translation units)
     std::shared_ptr<node> merge(std::shared_ptr<node> a, std::shared_ptr<node> b, const compile_args& args);
+
+    // Merge many AST roots at once, in time linear in the total node count.
+    // Equivalent to folding merge() over roots in order, but the roots are consumed:
+    // their subtrees are moved into the result (not cloned) and the roots are left empty.
+    // With thread_count > 1 (0 = hardware concurrency) contiguous ranges of roots are
+    // merged in parallel first; the result is identical for any thread count.
+    std::shared_ptr<node> merge_all(std::vector<std::shared_ptr<node>> roots, const compile_args& args,
+                                    unsigned thread_count = 1);
   };
 
 }  // namespace xccmeta
\ No newline at end of file
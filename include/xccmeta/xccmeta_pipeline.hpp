@@ -0,0 +1,78 @@
+/*
+MIT License
+
+Copyright (c) 2026 Christian Luppi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "xccmeta_compile_args.hpp"
+#include "xccmeta_import.hpp"
+#include "xccmeta_node.hpp"
+#include "xccmeta_usr_registry.hpp"
+
+namespace xccmeta {
+
+  // Reads and parses a batch of files, overlapping file I/O with parsing.
+  //
+  // Reader threads load file contents ahead of the parsers into a bounded queue;
+  // parse workers, each with its own parser, take files from it as they finish
+  // the previous one. A full queue stalls the readers (backpressure), so no more
+  // than queue_depth files wait in memory besides those being parsed.
+  class XCCMETA_API parse_pipeline {
+   public:
+    struct config {
+      unsigned read_threads = 2;   // Threads loading files ahead (0 = hardware concurrency)
+      unsigned parse_threads = 1;  // Threads running the parser (0 = hardware concurrency)
+
+      // Files read but not yet picked up by a parse worker, at most (minimum 1)
+      std::size_t queue_depth = 8;
+
+      // Cap on the bytes of those files (0 = no cap). A larger file is still
+      // admitted once the queue is empty, so it cannot stall the pipeline.
+      std::size_t queue_bytes = 0;
+
+      // Passed to parser::parse when set (see usr_registry)
+      usr_registry* registry = nullptr;
+    };
+
+    // Receives each parsed file on a parse thread; root is null if the file could
+    // not be read. With several parse threads, calls run concurrently and in no
+    // particular order.
+    using callback = std::function<void(std::size_t index, const file& source, node_ptr root)>;
+
+    parse_pipeline() = default;
+    explicit parse_pipeline(const config& cfg);
+
+    // One root per file, in the order of files (ready for parser::merge_all)
+    std::vector<node_ptr> run(const std::vector<file>& files, const compile_args& args) const;
+
+    // Streams roots to on_parsed instead of collecting them
+    void run(const std::vector<file>& files, const compile_args& args, const callback& on_parsed) const;
+
+   private:
+    config config_;
+  };
+
+}  // namespace xccmeta
@@ -48,7 +48,7 @@ namespace xccmeta {
    public:
     preprocessor_context();
     ~preprocessor_context();
-    preprocessor_context(const std::string& input, const compile_args& args = compile_args());
+    preprocessor_context(std::string_view input, const compile_args& args = compile_args());
 
     // Move operations (needed for Pimpl with unique_ptr)
     preprocessor_context(preprocessor_context&&) noexcept;
@@ -58,7 +58,7 @@ namespace xccmeta {
     preprocessor_context(const preprocessor_context&) = delete;
     preprocessor_context& operator=(const preprocessor_context&) = delete;
 
-    std::string apply(const std::string& to_preprocess, const compile_args& args = compile_args()) const;
+    std::string apply(std::string_view to_preprocess, const compile_args& args = compile_args()) const;
 
    private:
     struct internal_data;
@@ -0,0 +1,140 @@
+/*
+MIT License
+
+Copyright (c) 2026 Christian Luppi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <iterator>
+
+#include "xccmeta_node.hpp"
+
+namespace xccmeta {
+
+  // Declarative, CSS-like query over the AST, compiled once and reusable.
+  //
+  // SYNTAX:
+  //   selector   := compound (combinator compound)*      Several selectors can be joined with ','
+  //   combinator := '>'                                   Direct child
+  //               | whitespace                            Any descendant
+  //   compound   := (kind | '*')? (attribute | pseudo)*
+  //   kind       := node kind name, the "_decl" suffix is optional (e.g. struct, struct_decl, namespace)
+  //   attribute  := '[' '@' tag_name ']'                  Node has the tag
+  //               | '[' field op value ']'                field: name, qualified_name, display_name, usr, type
+  //                                                       op:    = (equal), != (not equal), ^= (prefix), $= (suffix), *= (substring)
+  //   pseudo     := ':not(' compound ')'
+  //               | ':' flag                              flag: definition, virtual, pure_virtual, override, final, static,
+  //                                                       const, inline, explicit, constexpr, noexcept, deleted, defaulted,
+  //                                                       anonymous, scoped, template, specialization, variadic, bitfield,
+  //                                                       virtual_base, public, protected, private
+  //   value      := quoted string | text up to ']'
+  //
+  // Example:
+  //   namespace[name=game] > struct[@reflect] > field:not([@skip])
+  //
+  // Ancestor combinators are only matched against nodes between the queried root
+  // and the candidate (the root itself included); the root is never a result.
+  // Invalid selectors never match anything, check is_valid() / get_error().
+  class XCCMETA_API selector {
+   public:
+    struct program;  // Compiled matcher (implementation detail)
+
+    // Lazy preorder traversal yielding the matching descendants of a root.
+    // The tree must not be modified while a selection is being iterated.
+    class XCCMETA_API selection {
+     public:
+      class XCCMETA_API iterator {
+       public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = node_ptr;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const node_ptr*;
+        using reference = const node_ptr&;
+
+        iterator() = default;
+
+        reference operator*() const { return current_; }
+        pointer operator->() const { return &current_; }
+        iterator& operator++() {
+          advance();
+          return *this;
+        }
+        void operator++(int) { advance(); }
+        bool operator==(const iterator& other) const { return current_ == other.current_; }
+        bool operator!=(const iterator& other) const { return current_ != other.current_; }
+
+       private:
+        friend class selection;
+        iterator(std::shared_ptr<const program> prog, const node_ptr& root);
+        void advance();
+
+        struct frame {
+          const node* parent;
+          std::size_t next_child;
+        };
+
+        std::shared_ptr<const program> program_;
+        std::vector<frame> stack_;
+        std::vector<const node*> path_;  // Ancestors of the next candidate, root first
+        node_ptr root_;
+        node_ptr current_;
+      };
+
+      iterator begin() const { return iterator(program_, root_); }
+      iterator end() const { return iterator(); }
+
+      // Drain the remaining matches into a vector
+      std::vector<node_ptr> to_vector() const;
+
+     private:
+      friend class selector;
+      selection(std::shared_ptr<const program> prog, node_ptr root);
+
+      std::shared_ptr<const program> program_;
+      node_ptr root_;
+    };
+
+    selector() = default;
+    explicit selector(const std::string& source);
+
+    // Compilation status
+    bool is_valid() const;
+    const std::string& get_error() const;  // Empty if valid
+    const std::string& get_source() const;
+
+    // Check a single node; ancestors are taken from the node's parent chain
+    bool matches(const node_ptr& n) const;
+
+    // Lazily iterate all matching descendants of root (preorder)
+    selection select(const node_ptr& root) const;
+
+    // Evaluate several selectors in a single traversal of root.
+    // result[i] holds the matches of selectors[i] in preorder.
+    static std::vector<std::vector<node_ptr>> select_many(const node_ptr& root, const std::vector<selector>& selectors);
+
+   private:
+    std::shared_ptr<const program> program_;
+    std::string source_;
+    std::string error_;
+  };
+
+}  // namespace xccmeta
@@ -0,0 +1,95 @@
+/*
+MIT License
+
+Copyright (c) 2026 Christian Luppi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <string_view>
+#include <unordered_map>
+
+#include "xccmeta_node.hpp"
+
+namespace xccmeta {
+
+  // Immutable, flattened view of a parsed tree that can be shared across threads.
+  //
+  // freeze() walks the tree once, numbers every node in preorder and warms all
+  // lazily memoized node data (e.g. inherited tag lists). Afterwards the snapshot
+  // and every const accessor of its nodes are read-only, so any number of threads
+  // may query them concurrently without locks.
+  //
+  // Navigation uses integer handles and raw node references, so it never touches
+  // shared_ptr reference counts. The snapshot keeps the root alive; the tree must
+  // not be modified (add_child, remove_child, add_tag, ...) while a snapshot exists.
+  class XCCMETA_API snapshot {
+   public:
+    using handle = std::uint32_t;
+    static constexpr handle invalid_handle = static_cast<handle>(-1);
+
+    snapshot() = default;
+
+    // Build a snapshot of the tree rooted at root
+    static snapshot freeze(const node_ptr& root);
+
+    bool empty() const;
+    std::size_t size() const;
+
+    // Root handle (always 0 for non-empty snapshots) and owning pointer
+    handle get_root() const;
+    const node_ptr& get_root_node() const;
+
+    // Node access
+    const node& get(handle h) const;
+    std::span<const node* const> get_nodes() const;  // All nodes in preorder, indexed by handle
+
+    // Navigation
+    handle get_parent(handle h) const;                    // invalid_handle for the root
+    std::span<const handle> get_children(handle h) const;  // In source order
+    std::size_t get_depth(handle h) const;                 // Root has depth 0
+    std::size_t get_subtree_size(handle h) const;          // Descendants of h are [h + 1, h + subtree_size)
+    bool is_ancestor(handle ancestor, handle descendant) const;
+
+    // Lookup (hash-based, O(1))
+    handle find(const node* n) const;              // Handle of a node in this snapshot
+    handle find_by_usr(std::string_view usr) const;  // Definitions win over declarations, then first in preorder
+
+   private:
+    struct data {
+      node_ptr root;
+      std::vector<const node*> nodes;
+      std::vector<handle> parents;
+      std::vector<std::uint32_t> depths;
+      std::vector<std::uint32_t> subtree_sizes;
+      std::vector<std::uint32_t> child_offsets;  // size() + 1 entries into child_handles
+      std::vector<handle> child_handles;
+      std::unordered_map<const node*, handle> by_node;
+      std::unordered_map<std::string_view, handle> by_usr;  // Views into node USR strings
+    };
+
+    std::shared_ptr<const data> data_;
+  };
+
+  // Convenience wrapper for snapshot::freeze()
+  XCCMETA_API snapshot freeze(const node_ptr& root);
+
+}  // namespace xccmeta
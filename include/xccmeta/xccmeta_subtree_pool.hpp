@@ -0,0 +1,94 @@
+/*
+MIT License
+
+Copyright (c) 2026 Christian Luppi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <unordered_map>
+
+#include "xccmeta_node.hpp"
+
+namespace xccmeta {
+
+  // Hash-consing of identical declarations across parsed trees.
+  //
+  // Every translation unit that includes a header gets its own copy of the
+  // header's declarations. intern() replaces each declaration subtree that is
+  // identical to one seen before (same structural hash including locations, see
+  // node::get_hash_with_locations(), and the same inherited tags) by the pooled
+  // instance, so the copies are released and all roots share one.
+  //
+  // Only declarations directly inside the translation unit, a namespace or a
+  // linkage spec are pooled; those scopes stay owned by each root, so their
+  // parent links and qualified names remain per tree.
+  //
+  // Shared subtrees are held by several parents and must not be modified
+  // (node::is_shared()). Their node::get_parent() is nullptr, their inherited
+  // tags are kept from when they were first shared, and the merger clones them
+  // instead of moving them. Use node_path to walk a tree with parents that
+  // follow the path taken.
+  //
+  // The pool holds its instances weakly: subtrees no longer referenced by any
+  // root are released, and their entries are dropped over time.
+  class XCCMETA_API subtree_pool {
+   public:
+    subtree_pool() = default;
+
+    // Share root's declarations with the pool: subtrees identical to a pooled
+    // one are replaced by it, the others are added to the pool. Type declaration
+    // links into replaced subtrees are redirected to the pooled nodes.
+    // Returns the number of nodes released from root.
+    std::size_t intern(const node_ptr& root);
+
+    bool contains(const node_ptr& n) const;  // n is a live pooled instance
+    std::size_t size() const;                // Number of live pooled subtrees
+    void clear();
+
+   private:
+    void sweep();  // Drop entries whose subtrees were released
+
+    // get_hash_with_locations() -> instances (several when inherited tags differ)
+    std::unordered_map<std::uint64_t, std::vector<node_weak_ptr>> by_hash_;
+    std::size_t entries_ = 0;    // Entries in by_hash_, live or not
+    std::size_t sweep_at_ = 64;  // sweep() once entries_ reaches this
+  };
+
+  // Position in a tree, kept as the path from the root. Parents come from the
+  // path rather than from the nodes, so they are right inside shared subtrees.
+  class XCCMETA_API node_path {
+   public:
+    explicit node_path(node_ptr root);
+
+    const node_ptr& get_root() const;
+    const node_ptr& get_node() const;
+    node_ptr get_parent() const;  // nullptr at the root
+    std::size_t get_depth() const;  // 0 at the root
+
+    bool to_child(std::size_t index);  // false (and no move) if out of range
+    bool to_parent();                  // false at the root
+
+   private:
+    std::vector<node_ptr> path_;
+  };
+
+}  // namespace xccmeta
@@ -30,6 +30,12 @@ SOFTWARE.
 
 namespace xccmeta {
 
+  // Compact integer identifier of an interned tag name.
+  // Tag names are interned into a process-wide table, so comparing two ids is
+  // equivalent to comparing the names. Ids are stable for the lifetime of the
+  // process and are never reused. The empty name always has id 0.
+  using tag_id = std::uint32_t;
+
   // Represents a metadata tag extracted from source code
   // Tags can be defined in two ways: comment style or attribute style.
   // 1) Comment Style: Tags are embedded within comments using a specific syntax.
@@ -60,19 +66,31 @@ namespace xccmeta {
 
   class XCCMETA_API tag {
    public:
+    static constexpr tag_id invalid_id = static_cast<tag_id>(-1);
+
     tag() = default;
     tag(const std::string& name, const std::vector<std::string>& args);
 
     static tag parse(const std::string& to_parse);  // must stricly be in this format: "tag(arg1, arg2)"
 
+    // Tag name interning (thread-safe)
+    static tag_id intern(const std::string& name);       // Get or create the id of a tag name
+    static tag_id lookup(const std::string& name);       // Get the id of a tag name, invalid_id if it was never interned
+    static const std::string& name_of(tag_id id);        // Get the name of an interned id (empty string for unknown ids)
+    static std::uint64_t mask_of(tag_id id) {            // Bloom bit of an id, used by node tag masks
+      return id == invalid_id ? 0 : (std::uint64_t {1} << (id & 63));
+    }
+
     std::string get_args_combined() const;             // Combined args as a single string, e.g., "arg1, arg2"
     std::string get_full() const;                      // Full representation excluding [[ and ]], e.g., xccmeta::tag_name(arg1, arg2)
     const std::string& get_name() const;               // e.g., xccmeta::tag_name
     const std::vector<std::string>& get_args() const;  // e.g., {arg1, arg2}
+    tag_id get_id() const;                             // Interned id of the name
 
    private:
     std::string name;
     std::vector<std::string> args;
+    tag_id id = 0;
   };
 
 }  // namespace xccmeta
\ No newline at end of file
@@ -0,0 +1,94 @@
+/*
+MIT License
+
+Copyright (c) 2026 Christian Luppi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <unordered_map>
+
+#include "xccmeta_node.hpp"
+
+namespace xccmeta {
+
+  // Dependency graph between the types declared in one or more parsed trees.
+  //
+  // There is one vertex per type USR (records, enums, typedefs, aliases and class
+  // templates). A type depends on the types named by its fields, bases, aliased
+  // type and their template arguments (see type_info::get_referenced_usrs).
+  // Self references are ignored.
+  //
+  // Trees are added and removed as a whole, so reparsing one file only touches
+  // the types that file declares: call update(old_root, new_root).
+  class XCCMETA_API type_graph {
+   public:
+    using vertex = std::uint32_t;
+    static constexpr vertex invalid_vertex = static_cast<vertex>(-1);
+
+    type_graph() = default;
+    explicit type_graph(const node_ptr& root);
+
+    // Incremental maintenance (typically one root per parsed file)
+    void add(const node_ptr& root);
+    void remove(const node_ptr& root);
+    void update(const node_ptr& old_root, const node_ptr& new_root);
+
+    // Vertices (vertex ids are stable across updates)
+    std::size_t size() const;                  // Number of declared types
+    std::vector<vertex> get_vertices() const;  // Declared types in ascending id order
+    vertex find(const std::string& usr) const;
+    vertex find(const node_ptr& n) const;
+    node_ptr get_node(vertex v) const;  // Chosen declaration (definitions preferred)
+    const std::string& get_usr(vertex v) const;
+
+    // Edges
+    std::vector<vertex> get_dependencies(vertex v) const;             // Direct
+    std::vector<vertex> get_dependents(vertex v) const;               // Direct, O(V + E)
+    std::vector<vertex> get_transitive_dependencies(vertex v) const;  // Dependencies first, excludes v
+
+    // Orderings, O(V + E)
+    std::vector<std::vector<vertex>> get_strongly_connected_components() const;  // Dependencies first
+    std::vector<vertex> get_topological_order() const;                            // Dependencies first, cycles kept together
+    bool has_cycles() const;
+
+   private:
+    struct declaration {
+      const node* root;
+      node_ptr decl;
+    };
+
+    struct vertex_data {
+      std::string usr;
+      std::vector<declaration> declarations;  // Empty for types only referenced, never declared
+      node_ptr chosen;
+      std::vector<vertex> edges;  // May point at undeclared vertices
+    };
+
+    vertex intern(const std::string& usr);
+    void refresh(vertex v);
+    bool is_declared(vertex v) const;
+
+    std::vector<vertex_data> vertices_;
+    std::unordered_map<std::string, vertex> by_usr_;
+  };
+
+}  // namespace xccmeta
@@ -26,6 +26,7 @@ SOFTWARE.
 
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include "xccmeta_base.hpp"
 
@@ -68,6 +69,15 @@ namespace xccmeta {
     // Size in bytes (if available, -1 otherwise)
     std::int64_t get_size_bytes() const;
 
+    // USR of the declared type this refers to, after stripping pointers, references
+    // and arrays and resolving typedefs (empty for builtins)
+    const std::string& get_declaration_usr() const;
+
+    // USRs of every declaration this type mentions: the declaration above, typedefs
+    // and aliases passed through, class templates and template arguments (recursively).
+    // Deduplicated, in discovery order.
+    const std::vector<std::string>& get_referenced_usrs() const;
+
     // Alignment in bytes (if available, -1 otherwise)
     std::int64_t get_alignment() const;
 
@@ -106,6 +116,8 @@ namespace xccmeta {
     void set_array_size(std::int64_t s);
     void set_size_bytes(std::int64_t s);
     void set_alignment(std::int64_t a);
+    void set_declaration_usr(const std::string& usr);
+    void add_referenced_usr(const std::string& usr);
 
    private:
     std::string spelling_;
@@ -124,6 +136,8 @@ namespace xccmeta {
     std::int64_t array_size_ = -1;
     std::int64_t size_bytes_ = -1;
     std::int64_t alignment_ = -1;
+    std::string declaration_usr_;
+    std::vector<std::string> referenced_usrs_;
   };
 
 }  // namespace xccmeta
\ No newline at end of file
@@ -0,0 +1,71 @@
+/*
+MIT License
+
+Copyright (c) 2026 Christian Luppi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <memory>
+#include <string_view>
+
+#include "xccmeta_base.hpp"
+
+namespace xccmeta {
+
+  // Thread-safe set of declaration USRs shared by parsers running in parallel.
+  //
+  // A parser given a registry claims every namespace-scope declaration before
+  // building its node. Declarations another parse already claimed are skipped
+  // together with their subtrees, so headers included by many translation units
+  // are only turned into nodes once. Merge the per-file roots afterwards
+  // (parser::merge_all) to get the complete tree.
+  //
+  // The USR set is split into independently locked stripes, so concurrent claims
+  // of different USRs rarely contend.
+  class XCCMETA_API usr_registry {
+   public:
+    usr_registry();
+    ~usr_registry();
+
+    // Non-copyable, non-movable (parsers hold references while running)
+    usr_registry(const usr_registry&) = delete;
+    usr_registry& operator=(const usr_registry&) = delete;
+
+    // Claim a declaration; returns true if the caller should build it.
+    // The first declaration of a USR is granted, and so is the first definition
+    // (which may follow a declaration). Everything else is refused.
+    bool claim(std::string_view usr, bool is_definition);
+
+    bool contains(std::string_view usr) const;
+    bool has_definition(std::string_view usr) const;  // A definition of usr was claimed
+
+    std::size_t size() const;  // Number of distinct USRs claimed
+    void clear();
+
+   private:
+    struct stripe;
+    stripe& stripe_for(std::string_view usr) const;
+
+    std::unique_ptr<stripe[]> stripes_;
+  };
+
+}  // namespace xccmeta
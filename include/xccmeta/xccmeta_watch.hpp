@@ -0,0 +1,120 @@
+/*
+MIT License
+
+Copyright (c) 2026 Christian Luppi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "xccmeta_compile_args.hpp"
+#include "xccmeta_import.hpp"
+#include "xccmeta_node.hpp"
+#include "xccmeta_pipeline.hpp"
+
+namespace xccmeta {
+
+  // Keeps the parsed trees of an importer's inputs up to date as files change.
+  //
+  // Each update() re-imports the inputs and compares them, and every header they
+  // depend on, against an in-memory manifest. Only changed and added inputs, and
+  // inputs depending on a changed header, are parsed again. Unchanged trees stay
+  // in memory between updates.
+  //
+  // On Linux, poll() and run() wait for inotify events on the input and header
+  // directories and call update() once the events settle. Elsewhere they only
+  // wait, and update() can be called on a timer instead.
+  //
+  // A header counts as a dependency of an input when declarations from it appear
+  // in the input's tree and it lies under a glob base of config::inputs or under
+  // one of config::dependency_dirs. Headers that only contribute macros are not seen.
+  //
+  // update(), poll() and run() must be called from one thread at a time.
+  // get_root(), get_dependencies() and stop() may be called from any thread.
+  class XCCMETA_API watcher {
+   public:
+    struct batch {
+      std::vector<file> parsed;   // Inputs parsed by this update, sorted by path
+      std::vector<path> removed;  // Inputs deleted or no longer matched
+    };
+
+    struct config {
+      importer::config inputs;  // manifest_path and only_changed are ignored
+      compile_args args;
+      parse_pipeline::config pipeline;  // Used for every (re)parse
+
+      // Further directories whose headers are tracked as dependencies
+      std::vector<path> dependency_dirs;
+
+      // Quiet time after the last event before an update starts
+      std::chrono::milliseconds debounce {100};
+
+      // Longest wait after the first event; files that keep changing are updated anyway
+      std::chrono::milliseconds max_delay {2000};
+
+      // Called on the updating thread, in this order, for each update with changes
+      std::function<void(const file& input, node_ptr root)> on_parsed;
+      std::function<void(const path& input)> on_removed;
+      std::function<void(const batch& changes)> on_batch;  // e.g. to regenerate outputs
+    };
+
+    explicit watcher(const config& cfg);
+    ~watcher();
+
+    // Non-copyable, non-movable (stop() may be called from other threads)
+    watcher(const watcher&) = delete;
+    watcher& operator=(const watcher&) = delete;
+
+    static bool is_supported();  // File events are available on this platform
+
+    // Re-imports, parses what changed and runs the callbacks. The first call
+    // parses every input. Returns true if anything was parsed or removed.
+    bool update();
+
+    // Waits up to timeout for file events, then debounces and calls update().
+    // Returns update()'s result, or false on timeout or stop().
+    bool poll(std::chrono::milliseconds timeout);
+
+    // update(), then poll() until stop(). Where file events are unavailable,
+    // update() runs once a second instead.
+    void run();
+    void stop();  // Thread-safe; also wakes a blocked poll()
+
+    // Inputs are looked up by the path the importer returned for them (as passed to
+    // on_parsed), not by their canonical path
+    node_ptr get_root(const path& input) const;                // Null if not an input
+    std::vector<path> get_dependencies(const path& input) const;  // Canonical header paths, sorted
+
+   private:
+    struct state;
+
+    bool drain_events();  // False if nothing but removed watches was queued
+    void watch_directories();
+
+    config config_;
+    std::unique_ptr<state> state_;
+  };
+
+}  // namespace xccmeta
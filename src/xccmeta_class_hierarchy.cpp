@@ -0,0 +1,319 @@
+/*
+MIT License
+
+Copyright (c) 2026 Christian Luppi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "xccmeta/xccmeta_class_hierarchy.hpp"
+
+#include <algorithm>
+#include <bit>
+
+namespace xccmeta {
+
+  namespace {
+
+    bool is_class(const node& n) {
+      return n.is_record_decl() || n.get_kind() == node::kind::class_template;
+    }
+
+    // USR of the class a base specifier names
+    const std::string& base_usr(const node& base) {
+      if (auto decl = base.get_type_declaration()) return decl->get_usr();
+      return base.get_type().get_declaration_usr();
+    }
+
+  }  // namespace
+
+  // ============================================================================
+  // bit_matrix
+  // ============================================================================
+
+  void class_hierarchy::bit_matrix::reset(std::size_t rows, std::size_t columns) {
+    words_per_row = (columns + 63) / 64;
+    bits.assign(rows * words_per_row, 0);
+  }
+
+  bool class_hierarchy::bit_matrix::test(std::size_t row, class_id col) const {
+    return (bits[row * words_per_row + col / 64] >> (col % 64)) & 1;
+  }
+
+  void class_hierarchy::bit_matrix::set(std::size_t row, class_id col) {
+    bits[row * words_per_row + col / 64] |= std::uint64_t {1} << (col % 64);
+  }
+
+  void class_hierarchy::bit_matrix::merge(std::size_t row, std::size_t from) {
+    std::uint64_t* dst = bits.data() + row * words_per_row;
+    const std::uint64_t* src = bits.data() + from * words_per_row;
+    for (std::size_t i = 0; i < words_per_row; ++i) dst[i] |= src[i];
+  }
+
+  std::vector<class_hierarchy::class_id> class_hierarchy::bit_matrix::row_members(std::size_t row) const {
+    std::vector<class_id> result;
+    const std::uint64_t* words = bits.data() + row * words_per_row;
+    for (std::size_t i = 0; i < words_per_row; ++i) {
+      for (std::uint64_t w = words[i]; w != 0; w &= w - 1) {
+        result.push_back(static_cast<class_id>(i * 64 + std::countr_zero(w)));
+      }
+    }
+    return result;
+  }
+
+  // ============================================================================
+  // Construction
+  // ============================================================================
+
+  class_hierarchy::class_hierarchy(const node_ptr& root) {
+    build({root});
+  }
+
+  class_hierarchy::class_hierarchy(const std::vector<node_ptr>& roots) {
+    build(roots);
+  }
+
+  void class_hierarchy::build(const std::vector<node_ptr>& roots) {
+    // Collect classes in preorder, one per USR, definitions preferred
+    std::vector<node_ptr> stack;
+    for (auto it = roots.rbegin(); it != roots.rend(); ++it) {
+      if (*it) stack.push_back(*it);
+    }
+    while (!stack.empty()) {
+      node_ptr n = std::move(stack.back());
+      stack.pop_back();
+      const auto& children = n->get_children();
+      stack.insert(stack.end(), children.rbegin(), children.rend());
+
+      if (!is_class(*n) || n->get_usr().empty()) continue;
+      auto [it, inserted] = by_usr_.emplace(n->get_usr(), static_cast<class_id>(nodes_.size()));
+      if (inserted) {
+        nodes_.push_back(std::move(n));
+      } else if (!nodes_[it->second]->is_definition() && n->is_definition()) {
+        nodes_[it->second] = std::move(n);
+      }
+    }
+
+    const std::size_t count = nodes_.size();
+    bases_.assign(count, {});
+    derived_.assign(count, {});
+
+    // Direct edges (bases outside the index are skipped)
+    for (class_id c = 0; c < count; ++c) {
+      for (const auto& base : nodes_[c]->get_bases()) {
+        class_id b = find(base_usr(*base));
+        if (b == invalid_class || b == c) continue;
+        bases_[c].push_back({b, base->is_virtual_base(), base->get_access()});
+        derived_[b].push_back(c);
+      }
+    }
+    for (auto& d : derived_) {
+      std::sort(d.begin(), d.end());
+      d.erase(std::unique(d.begin(), d.end()), d.end());
+    }
+
+    // Bases-first order (iterative post-order DFS over base edges)
+    std::vector<class_id> order;
+    order.reserve(count);
+    std::vector<bool> visited(count, false);
+    std::vector<std::pair<class_id, std::size_t>> dfs;
+    for (class_id start = 0; start < count; ++start) {
+      if (visited[start]) continue;
+      visited[start] = true;
+      dfs.push_back({start, 0});
+      while (!dfs.empty()) {
+        auto [c, pos] = dfs.back();
+        if (pos < bases_[c].size()) {
+          dfs.back().second++;
+          class_id b = bases_[c][pos].base;
+          if (!visited[b]) {
+            visited[b] = true;
+            dfs.push_back({b, 0});
+          }
+          continue;
+        }
+        dfs.pop_back();
+        order.push_back(c);
+      }
+    }
+
+    // Forest: a single base becomes the tree parent. Trees are numbered from
+    // their roots in preorder; classes on an inheritance cycle (ill-formed code)
+    // are reached from none, so the first one left over starts a tree itself.
+    tree_parent_.assign(count, invalid_class);
+    std::vector<std::vector<class_id>> tree_children(count);
+    for (class_id c = 0; c < count; ++c) {
+      if (bases_[c].size() == 1) {
+        tree_parent_[c] = bases_[c][0].base;
+        tree_children[bases_[c][0].base].push_back(c);
+      }
+    }
+
+    tree_root_.assign(count, invalid_class);
+    preorder_.assign(count, 0);
+    subtree_end_.assign(count, 0);
+    by_preorder_.clear();
+    by_preorder_.reserve(count);
+    auto number_tree = [&](class_id root) {
+      tree_parent_[root] = invalid_class;
+      std::vector<std::pair<class_id, std::size_t>> walk {{root, 0}};
+      tree_root_[root] = root;
+      preorder_[root] = static_cast<std::uint32_t>(by_preorder_.size());
+      by_preorder_.push_back(root);
+      while (!walk.empty()) {
+        auto& [c, pos] = walk.back();
+        if (pos < tree_children[c].size()) {
+          class_id child = tree_children[c][pos++];
+          if (tree_root_[child] != invalid_class) continue;  // Closes a cycle
+          tree_root_[child] = root;
+          preorder_[child] = static_cast<std::uint32_t>(by_preorder_.size());
+          by_preorder_.push_back(child);
+          walk.push_back({child, 0});
+          continue;
+        }
+        subtree_end_[c] = static_cast<std::uint32_t>(by_preorder_.size());
+        walk.pop_back();
+      }
+    };
+    for (class_id c = 0; c < count; ++c) {
+      if (tree_parent_[c] == invalid_class) number_tree(c);
+    }
+    for (class_id c = 0; c < count; ++c) {
+      if (tree_root_[c] == invalid_class) number_tree(c);
+    }
+
+    // Bit rows only for roots that have bases, filled bases-first
+    based_roots_.clear();
+    root_row_.assign(count, no_row);
+    for (class_id c : order) {
+      if (tree_parent_[c] == invalid_class && !bases_[c].empty()) {
+        root_row_[c] = static_cast<std::uint32_t>(based_roots_.size());
+        based_roots_.push_back(c);
+      }
+    }
+    root_bases_.reset(based_roots_.size(), count);
+    for (std::size_t row = 0; row < based_roots_.size(); ++row) {
+      for (const auto& link : bases_[based_roots_[row]]) {
+        class_id b = link.base;
+        for (; tree_parent_[b] != invalid_class; b = tree_parent_[b]) root_bases_.set(row, b);
+        root_bases_.set(row, b);
+        if (root_row_[b] != no_row && root_row_[b] != row) root_bases_.merge(row, root_row_[b]);
+      }
+    }
+
+    // Virtual bases flow from bases to derived classes
+    virtual_bases_.assign(count, {});
+    for (class_id c : order) {
+      auto& own = virtual_bases_[c];
+      for (const auto& link : bases_[c]) {
+        if (link.is_virtual) own.push_back(link.base);
+        own.insert(own.end(), virtual_bases_[link.base].begin(), virtual_bases_[link.base].end());
+      }
+      std::sort(own.begin(), own.end());
+      own.erase(std::unique(own.begin(), own.end()), own.end());
+    }
+  }
+
+  bool class_hierarchy::in_subtree(class_id c, class_id root) const {
+    return preorder_[root] < preorder_[c] && preorder_[c] < subtree_end_[root];
+  }
+
+  // ============================================================================
+  // Queries
+  // ============================================================================
+
+  std::size_t class_hierarchy::size() const {
+    return nodes_.size();
+  }
+
+  class_hierarchy::class_id class_hierarchy::find(const std::string& usr) const {
+    auto it = by_usr_.find(usr);
+    return it != by_usr_.end() ? it->second : invalid_class;
+  }
+
+  class_hierarchy::class_id class_hierarchy::find(const node_ptr& n) const {
+    return n ? find(n->get_usr()) : invalid_class;
+  }
+
+  const node_ptr& class_hierarchy::get_node(class_id c) const {
+    static const node_ptr null_node;
+    return c < nodes_.size() ? nodes_[c] : null_node;
+  }
+
+  std::span<const class_hierarchy::base_link> class_hierarchy::get_bases(class_id c) const {
+    if (c >= bases_.size()) return {};
+    return bases_[c];
+  }
+
+  std::span<const class_hierarchy::class_id> class_hierarchy::get_derived(class_id c) const {
+    if (c >= derived_.size()) return {};
+    return derived_[c];
+  }
+
+  bool class_hierarchy::is_derived_from(class_id derived, class_id base) const {
+    if (derived >= size() || base >= size() || derived == base) return false;
+    if (in_subtree(derived, base)) return true;
+    const std::uint32_t row = root_row_[tree_root_[derived]];
+    return row != no_row && root_bases_.test(row, base);
+  }
+
+  std::vector<class_hierarchy::class_id> class_hierarchy::get_all_derived(class_id c) const {
+    std::vector<class_id> result;
+    if (c >= size()) return result;
+
+    // c's own subtree, plus the whole tree of every based root that derives from c
+    result.insert(result.end(), by_preorder_.begin() + preorder_[c] + 1, by_preorder_.begin() + subtree_end_[c]);
+    for (std::size_t row = 0; row < based_roots_.size(); ++row) {
+      const class_id root = based_roots_[row];
+      if (root != c && !in_subtree(root, c) && root_bases_.test(row, c)) {
+        result.insert(result.end(), by_preorder_.begin() + preorder_[root], by_preorder_.begin() + subtree_end_[root]);
+      }
+    }
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+  }
+
+  std::vector<class_hierarchy::class_id> class_hierarchy::get_all_bases(class_id c) const {
+    std::vector<class_id> result;
+    if (c >= size()) return result;
+
+    for (class_id b = tree_parent_[c]; b != invalid_class; b = tree_parent_[b]) result.push_back(b);
+    const std::uint32_t row = root_row_[tree_root_[c]];
+    if (row != no_row) {
+      auto more = root_bases_.row_members(row);
+      result.insert(result.end(), more.begin(), more.end());
+    }
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    result.erase(std::remove(result.begin(), result.end(), c), result.end());  // Only on a cycle
+    return result;
+  }
+
+  bool class_hierarchy::is_virtual_base_of(class_id base, class_id derived) const {
+    if (derived >= size() || base >= size()) return false;
+    return std::binary_search(virtual_bases_[derived].begin(), virtual_bases_[derived].end(), base);
+  }
+
+  std::vector<class_hierarchy::class_id> class_hierarchy::get_virtual_bases(class_id c) const {
+    if (c >= size()) return {};
+    return virtual_bases_[c];
+  }
+
+}  // namespace xccmeta
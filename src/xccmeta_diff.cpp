@@ -0,0 +1,197 @@
+/*
+MIT License
+
+Copyright (c) 2026 Christian Luppi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "xccmeta/xccmeta_diff.hpp"
+
+#include <unordered_map>
+#include <vector>
+
+namespace xccmeta {
+
+  namespace {
+
+    bool same_type(const type_info& a, const type_info& b) {
+      return a.get_spelling() == b.get_spelling() && a.get_canonical() == b.get_canonical() &&
+             a.get_declaration_usr() == b.get_declaration_usr() && a.get_size_bytes() == b.get_size_bytes() &&
+             a.get_alignment() == b.get_alignment() && a.get_array_size() == b.get_array_size();
+    }
+
+    bool same_tags(const node& a, const node& b) {
+      const auto& ta = a.get_tags();
+      const auto& tb = b.get_tags();
+      if (ta.size() != tb.size()) return false;
+      for (std::size_t i = 0; i < ta.size(); ++i) {
+        if (ta[i].get_id() != tb[i].get_id() || ta[i].get_args() != tb[i].get_args()) return false;
+      }
+      return true;
+    }
+
+    std::uint64_t flag_bits(const node& n) {
+      std::uint64_t bits = 0;
+      for (bool b : {n.is_definition(), n.is_virtual(), n.is_pure_virtual(), n.is_override(), n.is_final(),
+                     n.is_static(), n.is_const_method(), n.is_inline(), n.is_explicit(), n.is_constexpr(),
+                     n.is_noexcept(), n.is_deleted(), n.is_defaulted(), n.is_anonymous(), n.is_scoped_enum(),
+                     n.is_template(), n.is_template_specialization(), n.is_variadic(), n.is_bitfield(),
+                     n.is_virtual_base(), n.has_default_value()}) {
+        bits = (bits << 1) | (b ? 1 : 0);
+      }
+      return bits;
+    }
+
+    // Changes of the node's own attributes (children excluded)
+    change_mask compare_attributes(const node& a, const node& b, const diff_options& options) {
+      change_mask mask = 0;
+      if (a.get_kind() != b.get_kind()) mask = mask | change::kind;
+      if (a.get_name() != b.get_name() || a.get_qualified_name() != b.get_qualified_name() ||
+          a.get_display_name() != b.get_display_name() || a.get_mangled_name() != b.get_mangled_name()) {
+        mask = mask | change::name;
+      }
+      if (!same_type(a.get_type(), b.get_type()) || !same_type(a.get_return_type(), b.get_return_type())) {
+        mask = mask | change::type;
+      }
+      if (a.get_access() != b.get_access() || a.get_storage_class() != b.get_storage_class()) {
+        mask = mask | change::access;
+      }
+      if (flag_bits(a) != flag_bits(b)) mask = mask | change::flags;
+      if (a.get_default_value() != b.get_default_value() || a.get_enum_value() != b.get_enum_value() ||
+          a.get_underlying_type() != b.get_underlying_type() || a.get_bitfield_width() != b.get_bitfield_width()) {
+        mask = mask | change::value;
+      }
+      if (a.get_comment() != b.get_comment() || a.get_brief_comment() != b.get_brief_comment()) {
+        mask = mask | change::comment;
+      }
+      if (!same_tags(a, b)) mask = mask | change::tags;
+      if (options.include_locations && (a.get_location() != b.get_location() || a.get_extent() != b.get_extent())) {
+        mask = mask | change::location;
+      }
+      return mask;
+    }
+
+    // Sibling matching key: USR, else kind + qualified name, else kind + display name
+    std::string match_key(const node& n) {
+      if (!n.get_usr().empty()) return n.get_usr();
+      std::string key = n.get_kind_name();
+      key += '|';
+      key += n.get_qualified_name().empty() ? n.get_display_name() : n.get_qualified_name();
+      return key;
+    }
+
+    class differ {
+     public:
+      differ(const diff_options& options, std::vector<diff_entry>& out): options_(options), out_(out) {
+      }
+
+      void compare(const node_ptr& a, const node_ptr& b) {
+        const bool identical = options_.include_locations ? a->get_hash_with_locations() == b->get_hash_with_locations()
+                                                          : a->get_hash() == b->get_hash();
+        if (identical && a->get_hash() != 0) return;
+
+        // Reserve the parent's slot so it precedes its children in the script
+        const std::size_t slot = out_.size();
+        out_.push_back({diff_entry::operation::changed, a, b, compare_attributes(*a, *b, options_)});
+
+        if (compare_children(a, b)) {
+          out_[slot].changes = out_[slot].changes | change::children;
+        }
+        // Slots left without changes are dropped by finish()
+      }
+
+      void finish() {
+        std::erase_if(out_, [](const diff_entry& e) { return e.op == diff_entry::operation::changed && e.changes == 0; });
+      }
+
+     private:
+      // Returns true if the set or order of direct children changed
+      bool compare_children(const node_ptr& a, const node_ptr& b) {
+        const auto& old_children = a->get_children();
+        const auto& new_children = b->get_children();
+
+        // Key -> new child indices in source order, consumed front to back
+        std::unordered_map<std::string, std::vector<std::size_t>> by_key;
+        by_key.reserve(new_children.size());
+        for (std::size_t i = new_children.size(); i-- > 0;) {
+          by_key[match_key(*new_children[i])].push_back(i);
+        }
+
+        std::vector<bool> matched(new_children.size(), false);
+        bool structure_changed = old_children.size() != new_children.size();
+        std::size_t last_match = 0;
+        bool any_match = false;
+
+        for (const auto& old_child : old_children) {
+          auto it = by_key.find(match_key(*old_child));
+          if (it == by_key.end() || it->second.empty()) {
+            out_.push_back({diff_entry::operation::removed, old_child, nullptr, 0});
+            structure_changed = true;
+            continue;
+          }
+
+          std::size_t index = it->second.back();
+          it->second.pop_back();
+          matched[index] = true;
+          if (any_match && index < last_match) structure_changed = true;
+          last_match = index;
+          any_match = true;
+
+          compare(old_child, new_children[index]);
+        }
+
+        for (std::size_t i = 0; i < new_children.size(); ++i) {
+          if (!matched[i]) {
+            out_.push_back({diff_entry::operation::added, nullptr, new_children[i], 0});
+            structure_changed = true;
+          }
+        }
+        return structure_changed;
+      }
+
+      const diff_options& options_;
+      std::vector<diff_entry>& out_;
+    };
+
+  }  // namespace
+
+  std::vector<diff_entry> diff(const node_ptr& old_root, const node_ptr& new_root, const diff_options& options) {
+    std::vector<diff_entry> result;
+    if (!old_root && !new_root) return result;
+    if (!new_root) {
+      result.push_back({diff_entry::operation::removed, old_root, nullptr, 0});
+      return result;
+    }
+    if (!old_root) {
+      result.push_back({diff_entry::operation::added, nullptr, new_root, 0});
+      return result;
+    }
+
+    differ d(options, result);
+    d.compare(old_root, new_root);
+    d.finish();
+    return result;
+  }
+
+  std::vector<diff_entry> diff(const node_ptr& old_root, const node_ptr& new_root) {
+    return diff(old_root, new_root, diff_options {});
+  }
+
+}  // namespace xccmeta
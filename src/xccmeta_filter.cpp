@@ -25,60 +25,318 @@ SOFTWARE.
 #include <xccmeta/xccmeta_filter.hpp>
 
 #include <algorithm>
+#include <functional>
+#include <iterator>
+#include <thread>
 
 namespace xccmeta {
 
+  namespace {
+    constexpr std::size_t kind_count = static_cast<std::size_t>(node::kind::static_assert_decl) + 1;
+    static_assert(kind_count <= 64, "node::kind no longer fits the filter kind mask");
+
+    constexpr std::uint64_t kind_bit(node::kind k) {
+      return std::uint64_t {1} << static_cast<unsigned>(k);
+    }
+
+    // Glob match of one segment: '*' any run of characters, '?' one character
+    bool glob_match(std::string_view pattern, std::string_view text) {
+      std::size_t p = 0, t = 0;
+      std::size_t star = std::string_view::npos, resume = 0;
+      while (t < text.size()) {
+        if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == text[t])) {
+          p++;
+          t++;
+        } else if (p < pattern.size() && pattern[p] == '*') {
+          star = p++;
+          resume = t;
+        } else if (star != std::string_view::npos) {
+          p = star + 1;
+          t = ++resume;
+        } else {
+          return false;
+        }
+      }
+      while (p < pattern.size() && pattern[p] == '*') p++;
+      return p == pattern.size();
+    }
+
+    // Split the first "::" segment off name; more is false once name is used up
+    std::string_view next_segment(std::string_view& name, bool& more) {
+      const std::size_t sep = name.find("::");
+      std::string_view segment = name.substr(0, sep);
+      if (sep == std::string_view::npos) {
+        name = {};
+        more = false;
+      } else {
+        name.remove_prefix(sep + 2);
+      }
+      return segment;
+    }
+  }  // namespace
+
   filter::filter(const config& cfg): config_(cfg) {
+    if (!config_.allowed_kinds.empty()) {
+      kind_mask_ = 0;
+      for (node::kind k : config_.allowed_kinds) kind_mask_ |= kind_bit(k);
+    }
+
+    for (const auto& pattern : config_.name_patterns) name_patterns_.add(pattern);
+    for (const auto& pattern : config_.avoid_name_patterns) avoid_name_patterns_.add(pattern);
+
+    // Intern (rather than look up) so names not yet seen by the parser still get stable ids
+    for (const auto& name : config_.grab_tag_names) {
+      tag_id id = tag::intern(name);
+      add_to_set(grab_tags_, id);
+      grab_tag_mask_ |= tag::mask_of(id);
+    }
+    for (const auto& name : config_.avoid_tag_names) {
+      tag_id id = tag::intern(name);
+      add_to_set(avoid_tags_, id);
+      avoid_tag_mask_ |= tag::mask_of(id);
+    }
+  }
+
+  void filter::add_to_set(tag_set& set, tag_id id) {
+    if (id / 64 >= set.size()) set.resize(id / 64 + 1, 0);
+    set[id / 64] |= std::uint64_t {1} << (id % 64);
+  }
+
+  bool filter::has_tag_in(const node& type, const tag_set& set) {
+    for (const auto& t : type.get_tags()) {
+      const tag_id id = t.get_id();
+      if (id / 64 < set.size() && (set[id / 64] >> (id % 64)) & 1) return true;
+    }
+    return false;
   }
 
   filter& filter::clean() {
+    compact();
     types_.erase(
         std::remove_if(types_.begin(), types_.end(), [this](const node_ptr& type) {
           return !matches_config(type);
         }),
         types_.end());
+    rebuild_index();
     return *this;
   }
 
   bool filter::contains(const node_ptr& type) const {
     if (!type) return false;
-    return find_by_usr(type->get_usr()) != types_.end();
+    return find_slot(type->get_usr(), hash_usr(type->get_usr())) != no_slot;
   }
 
   bool filter::add(const node_ptr& type) {
     if (!type) return false;
     if (!is_valid_type(type)) return false;
-    if (contains(type)) return false;
+    return insert(type);
+  }
 
+  bool filter::insert(const node_ptr& type) {
+    const std::uint64_t hash = hash_usr(type->get_usr());
+    if (find_slot(type->get_usr(), hash) != no_slot) return false;
+
+    // Keep the table at most half full (deleted slots count, they lengthen probes)
+    if ((used_slots_ + 1) * 2 > index_.size()) {
+      rebuild_index();
+    }
     types_.push_back(type);
+    insert_slot(hash, static_cast<std::uint32_t>(types_.size() - 1));
     return true;
   }
 
+  // =============================================================================
+  // Tree ingestion
+  // =============================================================================
+
+  std::size_t filter::add_tree(const node_ptr& root, unsigned thread_count) {
+    if (!root) return 0;
+
+    const bool root_matched = is_valid_type(root);
+    std::vector<tree_candidate> candidates;
+    if (root_matched) candidates.push_back({0, 0, root});
+
+    const auto& subtrees = root->get_children();
+    if (thread_count == 0) thread_count = std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t workers = std::min<std::size_t>(thread_count, subtrees.size());
+
+    if (workers <= 1) {
+      for (std::size_t i = 0; i < subtrees.size(); ++i) {
+        collect_subtree(root, root_matched, i + 1, subtrees[i], candidates);
+      }
+    } else {
+      // Contiguous ranges of subtrees per worker; the filter is only read here
+      std::vector<std::vector<tree_candidate>> parts(workers);
+      std::vector<std::thread> threads;
+      threads.reserve(workers);
+      for (std::size_t w = 0; w < workers; ++w) {
+        const std::size_t first = subtrees.size() * w / workers;
+        const std::size_t last = subtrees.size() * (w + 1) / workers;
+        threads.emplace_back([&, w, first, last] {
+          for (std::size_t i = first; i < last; ++i) {
+            collect_subtree(root, root_matched, i + 1, subtrees[i], parts[w]);
+          }
+        });
+      }
+      for (auto& t : threads) t.join();
+      for (auto& part : parts) {
+        candidates.insert(candidates.end(), std::make_move_iterator(part.begin()), std::make_move_iterator(part.end()));
+      }
+    }
+
+    // Ancestors pulled in by parent inclusion were recorded after their descendants
+    std::stable_sort(candidates.begin(), candidates.end(), [](const tree_candidate& a, const tree_candidate& b) {
+      return a.group != b.group ? a.group < b.group : a.order < b.order;
+    });
+
+    std::size_t added = 0;
+    for (const auto& c : candidates) {
+      if (insert(c.node)) added++;
+    }
+    return added;
+  }
+
+  void filter::collect_subtree(const node_ptr& root, bool root_matched, std::size_t group, const node_ptr& subtree,
+                               std::vector<tree_candidate>& out) const {
+    using inclusion = config::node_inclusion;
+    const inclusion child_mode = config_.child_node_inclusion;
+    const inclusion parent_mode = config_.parent_node_inclusion;
+
+    struct frame {
+      const node_ptr* node;
+      std::size_t order;
+      bool matched;          // Passed the full config rules
+      bool grants_all;       // Every descendant is included (recursive child inclusion)
+      bool emitted;          // Already in out (or added by the caller)
+      bool ancestors_done;   // Parent inclusion already walked above this frame
+    };
+
+    std::vector<frame> path;
+    path.push_back({&root, 0, root_matched, root_matched && child_mode == inclusion::include_recursively, root_matched, false});
+
+    std::vector<std::pair<const node_ptr*, std::size_t>> stack {{&subtree, 1}};
+    std::size_t next_order = 1;
+
+    while (!stack.empty()) {
+      auto [node_ref, depth] = stack.back();
+      stack.pop_back();
+      path.resize(depth);
+
+      const frame& parent = path.back();
+      const node_ptr& n = *node_ref;
+      const bool matched = is_valid_type(n);
+      const bool granted = !matched && (parent.grants_all || (parent.matched && child_mode == inclusion::include)) &&
+                           matches_inclusion(n);
+
+      frame f {node_ref, next_order++, matched, parent.grants_all || (matched && child_mode == inclusion::include_recursively),
+               matched || granted, false};
+      if (f.emitted) out.push_back({group, f.order, n});
+      path.push_back(f);
+
+      if (matched && parent_mode != inclusion::exclude) {
+        for (std::size_t i = path.size() - 1; i-- > 0;) {
+          frame& ancestor = path[i];
+          if (!ancestor.emitted && matches_inclusion(*ancestor.node)) {
+            ancestor.emitted = true;
+            out.push_back({i == 0 ? 0 : group, ancestor.order, *ancestor.node});
+          }
+          if (parent_mode == inclusion::include || ancestor.ancestors_done) break;
+          ancestor.ancestors_done = true;
+        }
+      }
+
+      const auto& children = n->get_children();
+      for (auto it = children.rbegin(); it != children.rend(); ++it) {
+        stack.push_back({&*it, depth + 1});
+      }
+    }
+  }
+
+  bool filter::matches_inclusion(const node_ptr& type) const {
+    if (!type || !type->is_type_decl()) return false;
+    if ((kind_mask_ & kind_bit(type->get_kind())) == 0) return false;
+
+    // Grab tags and name patterns are bypassed, avoid rules still exclude
+    if ((type->get_tag_mask() & avoid_tag_mask_) != 0 && has_tag_in(*type, avoid_tags_)) return false;
+    return avoid_name_patterns_.empty() || !avoid_name_patterns_.matches(type->get_qualified_name());
+  }
+
   bool filter::remove(const node_ptr& type) {
     if (!type) return false;
 
-    auto it = find_by_usr(type->get_usr());
-    if (it == types_.end()) return false;
+    std::size_t slot = find_slot(type->get_usr(), hash_usr(type->get_usr()));
+    if (slot == no_slot) return false;
 
-    types_.erase(it);
+    types_[index_[slot].position].reset();
+    index_[slot].position = deleted_slot;
+    removed_++;
+    if (removed_ * 2 > types_.size()) compact();
     return true;
   }
 
   filter& filter::clear() {
     types_.clear();
+    index_.clear();
+    used_slots_ = 0;
+    removed_ = 0;
+    return *this;
+  }
+
+  // =============================================================================
+  // Set algebra
+  // =============================================================================
+
+  template <typename Pred>
+  void filter::retain_if(Pred pred) {
+    compact();
+    types_.erase(std::remove_if(types_.begin(), types_.end(), [&](const node_ptr& type) { return !pred(type); }),
+                 types_.end());
+    rebuild_index();
+  }
+
+  filter& filter::unite(const filter& other) {
+    if (&other == this) return *this;
+    for (const auto& type : other.types_) {
+      if (type) insert(type);
+    }
+    return *this;
+  }
+
+  filter& filter::intersect(const filter& other) {
+    if (&other == this) return *this;
+    retain_if([&](const node_ptr& type) { return other.contains(type); });
+    return *this;
+  }
+
+  filter& filter::subtract(const filter& other) {
+    if (&other == this) return clear();
+    retain_if([&](const node_ptr& type) { return !other.contains(type); });
+    return *this;
+  }
+
+  filter& filter::symmetric_difference(const filter& other) {
+    if (&other == this) return clear();
+
+    // Decide what other contributes before this list changes
+    std::vector<const node_ptr*> extra;
+    for (const auto& type : other.types_) {
+      if (type && !contains(type)) extra.push_back(&type);
+    }
+    subtract(other);
+    for (const node_ptr* type : extra) insert(*type);
     return *this;
   }
 
   std::size_t filter::size() const {
-    return types_.size();
+    return types_.size() - removed_;
   }
 
   bool filter::empty() const {
-    return types_.empty();
+    return size() == 0;
   }
 
-  const std::vector<node_ptr>& filter::get_types() const {
-    return types_;
+  filter::type_range filter::get_types() const {
+    return type_range(types_, size());
   }
 
   const filter::config& filter::get_config() const {
@@ -95,63 +353,142 @@ namespace xccmeta {
     return matches_config(type);
   }
 
-  std::vector<node_ptr>::iterator filter::find_by_usr(const std::string& usr) {
-    return std::find_if(types_.begin(), types_.end(), [&usr](const node_ptr& n) {
-      return n && n->get_usr() == usr;
-    });
-  }
+  // =============================================================================
+  // USR index
+  // =============================================================================
 
-  std::vector<node_ptr>::const_iterator filter::find_by_usr(const std::string& usr) const {
-    return std::find_if(types_.cbegin(), types_.cend(), [&usr](const node_ptr& n) {
-      return n && n->get_usr() == usr;
-    });
+  std::uint64_t filter::hash_usr(const std::string& usr) {
+    return std::hash<std::string> {}(usr);
   }
 
-  bool filter::matches_config(const node_ptr& type) const {
-    if (!type) return false;
+  std::size_t filter::find_slot(const std::string& usr, std::uint64_t hash) const {
+    if (index_.empty()) return no_slot;
 
-    const auto kind = type->get_kind();
+    const std::size_t mask = index_.size() - 1;
+    for (std::size_t i = hash & mask;; i = (i + 1) & mask) {
+      const index_slot& slot = index_[i];
+      if (slot.position == empty_slot) return no_slot;
+      if (slot.position != deleted_slot && slot.hash == hash && types_[slot.position]->get_usr() == usr) {
+        return i;
+      }
+    }
+  }
 
-    // Check allowed_kinds filter (if not empty, only allow types in the list)
-    if (!config_.allowed_kinds.empty()) {
-      bool kind_allowed = std::find(config_.allowed_kinds.begin(),
-                                    config_.allowed_kinds.end(),
-                                    kind) != config_.allowed_kinds.end();
-      if (!kind_allowed) return false;
+  void filter::insert_slot(std::uint64_t hash, std::uint32_t position) {
+    const std::size_t mask = index_.size() - 1;
+    std::size_t i = hash & mask;
+    while (index_[i].position != empty_slot) {
+      i = (i + 1) & mask;
     }
+    index_[i] = {hash, position};
+    used_slots_++;
+  }
 
-    // Check tag-based filtering
-    bool has_tags = !type->get_tags().empty();
+  void filter::rebuild_index() {
+    std::size_t capacity = 16;
+    while (capacity < (types_.size() + 1) * 2) capacity *= 2;
 
-    if (has_tags) {
-      // Check avoid_tag_names - if type has any of these tags, exclude it
-      for (const auto& avoid_tag : config_.avoid_tag_names) {
-        if (type->has_tag(avoid_tag)) {
-          return false;
-        }
-      }
+    index_.assign(capacity, index_slot {0, empty_slot});
+    used_slots_ = 0;
 
-      // Check grab_tag_names - if not empty, type must have at least one of these tags
-      if (!config_.grab_tag_names.empty()) {
-        bool has_grab_tag = false;
-        for (const auto& grab_tag : config_.grab_tag_names) {
-          if (type->has_tag(grab_tag)) {
-            has_grab_tag = true;
-            break;
-          }
-        }
-        if (!has_grab_tag) return false;
+    const std::size_t mask = capacity - 1;
+    for (std::size_t position = 0; position < types_.size(); ++position) {
+      if (!types_[position]) continue;
+      const std::uint64_t hash = hash_usr(types_[position]->get_usr());
+      std::size_t i = hash & mask;
+      while (index_[i].position != empty_slot) {
+        i = (i + 1) & mask;
       }
-    } else {
-      // Type has no tags - check if we should include untagged types
-      // If grab_tag_names is not empty and type has no tags, exclude it
-      // (unless child/parent inclusion allows it, but that's handled elsewhere)
-      if (!config_.grab_tag_names.empty()) {
-        return false;
+      index_[i] = {hash, static_cast<std::uint32_t>(position)};
+      used_slots_++;
+    }
+  }
+
+  void filter::compact() {
+    if (removed_ == 0) return;
+    types_.erase(std::remove(types_.begin(), types_.end(), nullptr), types_.end());
+    removed_ = 0;
+    rebuild_index();
+  }
+
+  bool filter::matches_config(const node_ptr& type) const {
+    return type && matches(*type);
+  }
+
+  std::vector<bool> filter::matches_many(std::span<const node_ptr> types) const {
+    std::vector<bool> result(types.size());
+    for (std::size_t i = 0; i < types.size(); ++i) {
+      result[i] = types[i] && matches(*types[i]);
+    }
+    return result;
+  }
+
+  bool filter::matches(const node& type) const {
+    if ((kind_mask_ & kind_bit(type.get_kind())) == 0) return false;
+
+    // The bloom masks reject most nodes before their tags are looked at; an
+    // untagged node has an empty mask, so it never passes a grab list
+    const std::uint64_t mask = type.get_tag_mask();
+    if ((mask & avoid_tag_mask_) != 0 && has_tag_in(type, avoid_tags_)) return false;
+    if (!config_.grab_tag_names.empty() && ((mask & grab_tag_mask_) == 0 || !has_tag_in(type, grab_tags_))) return false;
+
+    const std::string& name = type.get_qualified_name();
+    if (!name_patterns_.empty() && !name_patterns_.matches(name)) return false;
+    return avoid_name_patterns_.empty() || !avoid_name_patterns_.matches(name);
+  }
+
+  // =============================================================================
+  // Name patterns
+  // =============================================================================
+
+  void filter::name_trie::add(std::string_view pattern) {
+    if (pattern.empty()) return;
+
+    std::uint32_t current = 0;
+    bool more = true;
+    while (more) {
+      const std::string_view segment = next_segment(pattern, more);
+      auto& next = states_[current].next;
+      auto it = std::find_if(next.begin(), next.end(), [&](std::uint32_t s) { return states_[s].segment == segment; });
+      if (it != next.end()) {
+        current = *it;
+        continue;
       }
+      state s;
+      s.segment = std::string(segment);
+      s.any_segments = segment == "**";
+      states_.push_back(std::move(s));
+      const auto id = static_cast<std::uint32_t>(states_.size() - 1);
+      states_[current].next.push_back(id);
+      current = id;
     }
+    states_[current].accept = true;
+  }
 
-    return true;
+  bool filter::name_trie::matches(std::string_view qualified_name) const {
+    return matches_from(0, qualified_name, !qualified_name.empty());
+  }
+
+  bool filter::name_trie::matches_from(std::uint32_t s, std::string_view rest, bool more) const {
+    const state& current = states_[s];
+    if (!more && current.accept) return true;
+
+    std::string_view tail = rest;
+    bool tail_more = more;
+    const std::string_view segment = more ? next_segment(tail, tail_more) : std::string_view {};
+
+    // "**" may swallow another segment and stay put
+    if (current.any_segments && more && matches_from(s, tail, tail_more)) return true;
+
+    for (std::uint32_t n : current.next) {
+      const state& candidate = states_[n];
+      if (candidate.any_segments) {
+        if (matches_from(n, rest, more)) return true;  // Zero segments so far
+      } else if (more && glob_match(candidate.segment, segment) && matches_from(n, tail, tail_more)) {
+        return true;
+      }
+    }
+    return false;
   }
 
 }  // namespace xccmeta
\ No newline at end of file
@@ -23,7 +23,27 @@ SOFTWARE.
 */
 
 #include "xccmeta/xccmeta_import.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
 #include <fstream>
+#include <iterator>
+#include <mutex>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#  include <cerrno>
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#  define XCCMETA_HAS_POSIX_IO 1
+#endif
 
 namespace xccmeta {
 
@@ -38,21 +58,171 @@ namespace xccmeta {
     return std::filesystem::exists(file_path);
   }
 
+  namespace {
+
+#if defined(XCCMETA_HAS_POSIX_IO)
+    // Read a whole file into a buffer sized from fstat, normally in one read()
+    // (files reporting a size of 0, like /proc entries, grow the buffer instead)
+    bool read_fd(int fd, std::size_t size_hint, std::string& out) {
+      out.resize(size_hint > 0 ? size_hint : 4096);
+      std::size_t used = 0;
+      for (;;) {
+        if (used == out.size()) out.resize(out.size() * 2);
+        const ssize_t n = ::read(fd, out.data() + used, out.size() - used);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) {
+          out.clear();
+          return false;
+        }
+        if (n == 0) break;
+        used += static_cast<std::size_t>(n);
+        if (used == size_hint) break;  // Got the whole file; skip the extra read for EOF
+      }
+      out.resize(used);
+      return true;
+    }
+#endif
+
+    bool read_whole(const path& file_path, std::string& out) {
+#if defined(XCCMETA_HAS_POSIX_IO)
+      const int fd = ::open(file_path.c_str(), O_RDONLY | O_CLOEXEC);
+      if (fd < 0) {
+        return false;
+      }
+      struct stat info {};
+      const bool ok = ::fstat(fd, &info) == 0 && S_ISREG(info.st_mode) &&
+                      read_fd(fd, static_cast<std::size_t>(info.st_size), out);
+      ::close(fd);
+      return ok;
+#else
+      std::error_code ec;
+      if (!std::filesystem::is_regular_file(file_path, ec)) {
+        return false;
+      }
+      std::ifstream file_stream(file_path, std::ios::in | std::ios::binary | std::ios::ate);
+      if (!file_stream) {
+        return false;
+      }
+      const std::streamoff size = file_stream.tellg();
+      out.resize(size > 0 ? static_cast<std::size_t>(size) : 0);
+      file_stream.seekg(0);
+      file_stream.read(out.data(), static_cast<std::streamsize>(out.size()));
+      out.resize(static_cast<std::size_t>(file_stream.gcount()));
+      return true;
+#endif
+    }
+
+  }  // namespace
+
   std::string file::read() const {
-    if (!exists()) {
-      return "";
+    std::string content;
+    read_whole(file_path, content);
+    return content;
+  }
+
+  mapped_file file::map() const {
+    mapped_file result;
+
+#if defined(XCCMETA_HAS_POSIX_IO)
+    const int fd = ::open(file_path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      return result;
     }
 
-    std::ifstream file_stream(file_path, std::ios::in | std::ios::binary);
-    if (!file_stream) {
-      return "";
+    struct stat info {};
+    if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+      ::close(fd);
+      return result;
+    }
+
+    const auto size = static_cast<std::size_t>(info.st_size);
+    if (size > 0) {
+      void* addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (addr != MAP_FAILED) {
+        ::close(fd);
+        result.content = static_cast<const char*>(addr);
+        result.length = size;
+        result.valid = true;
+        result.mapped = true;
+        return result;
+      }
+    }
+
+    // Empty files (nothing to map) or mmap failure
+    result.valid = read_fd(fd, size, result.buffer);
+    ::close(fd);
+#else
+    result.valid = read_whole(file_path, result.buffer);
+#endif
+
+    result.content = result.buffer.data();
+    result.length = result.buffer.size();
+    return result;
+  }
+
+  // =============================================================================
+  // mapped_file
+  // =============================================================================
+
+  mapped_file::~mapped_file() {
+    release();
+  }
+
+  mapped_file::mapped_file(mapped_file&& other) noexcept {
+    *this = std::move(other);
+  }
+
+  mapped_file& mapped_file::operator=(mapped_file&& other) noexcept {
+    if (this == &other) return *this;
+    release();
+
+    valid = other.valid;
+    mapped = other.mapped;
+    length = other.length;
+    buffer = std::move(other.buffer);
+    // A moved buffer may have changed address (small string storage)
+    content = mapped ? other.content : buffer.data();
+
+    other.content = nullptr;
+    other.length = 0;
+    other.valid = false;
+    other.mapped = false;
+    return *this;
+  }
+
+  void mapped_file::release() {
+#if defined(XCCMETA_HAS_POSIX_IO)
+    if (mapped && content) {
+      ::munmap(const_cast<char*>(content), length);
     }
+#endif
+    content = nullptr;
+    length = 0;
+    valid = false;
+    mapped = false;
+    buffer.clear();
+  }
+
+  bool mapped_file::is_valid() const {
+    return valid;
+  }
 
-    std::string content((std::istreambuf_iterator<char>(file_stream)),
-                        std::istreambuf_iterator<char>());
+  bool mapped_file::is_mapped() const {
+    return mapped;
+  }
+
+  std::string_view mapped_file::view() const {
+    return {content ? content : "", length};
+  }
+
+  const char* mapped_file::data() const {
     return content;
   }
 
+  std::size_t mapped_file::size() const {
+    return length;
+  }
+
   bool file::write(const std::string& content) const {
     std::ofstream file_stream(file_path, std::ios::out | std::ios::binary);
     if (!file_stream) {
@@ -63,17 +233,633 @@ namespace xccmeta {
     return true;
   }
 
-  importer::importer(const std::string& wildcard) {
-    std::filesystem::path base_path = std::filesystem::path(wildcard).parent_path();
-    std::string pattern = std::filesystem::path(wildcard).filename().string();
+  // =============================================================================
+  // glob
+  // =============================================================================
+
+  namespace {
+
+    bool has_wildcards(std::string_view segment) {
+      return segment.find_first_of("*?[") != std::string_view::npos;
+    }
+
+    // Split the first '/' segment off text; more is false once text is used up
+    std::string_view next_segment(std::string_view& text, bool& more) {
+      const std::size_t sep = text.find('/');
+      std::string_view segment = text.substr(0, sep);
+      if (sep == std::string_view::npos) {
+        text = {};
+        more = false;
+      } else {
+        text.remove_prefix(sep + 1);
+        more = !text.empty();  // A trailing '/' ends the path
+      }
+      return segment;
+    }
+
+    // Match one pattern element ('?', a class or a plain character) at pattern[p]
+    // against c. Sets next to the index after the element.
+    bool match_element(std::string_view pattern, std::size_t p, char c, std::size_t& next) {
+      if (pattern[p] == '?') {
+        next = p + 1;
+        return true;
+      }
+      if (pattern[p] == '[') {
+        std::size_t i = p + 1;
+        const bool negate = i < pattern.size() && (pattern[i] == '!' || pattern[i] == '^');
+        if (negate) i++;
+        bool found = false;
+        const std::size_t first = i;
+        // ']' right after the opening bracket is a literal member
+        while (i < pattern.size() && (pattern[i] != ']' || i == first)) {
+          if (i + 2 < pattern.size() && pattern[i + 1] == '-' && pattern[i + 2] != ']') {
+            if (pattern[i] <= c && c <= pattern[i + 2]) found = true;
+            i += 3;
+          } else {
+            if (pattern[i] == c) found = true;
+            i++;
+          }
+        }
+        if (i < pattern.size()) {
+          next = i + 1;
+          return found != negate;
+        }
+        // Unterminated class: '[' is a plain character
+      }
+      next = p + 1;
+      return pattern[p] == c;
+    }
+
+    // Glob match of one segment, backtracking only to the last '*'
+    bool match_segment(std::string_view pattern, std::string_view text) {
+      std::size_t p = 0, t = 0;
+      std::size_t star = std::string_view::npos, resume = 0;
+      while (t < text.size()) {
+        std::size_t next = 0;
+        if (p < pattern.size() && pattern[p] == '*') {
+          star = p++;
+          resume = t;
+        } else if (p < pattern.size() && match_element(pattern, p, text[t], next)) {
+          p = next;
+          t++;
+        } else if (star != std::string_view::npos) {
+          p = star + 1;
+          t = ++resume;
+        } else {
+          return false;
+        }
+      }
+      while (p < pattern.size() && pattern[p] == '*') p++;
+      return p == pattern.size();
+    }
+
+  }  // namespace
+
+  glob::glob(std::string_view pattern) {
+    bool more = !pattern.empty();
+    bool first = true;
+    while (more) {
+      std::string_view text = next_segment(pattern, more);
+      // Keep the empty first segment of absolute paths, drop other empty ones
+      if (text.empty() && !first) continue;
+      first = false;
+
+      segment seg;
+      seg.text = std::string(text);
+      seg.any_directories = text == "**";
+      seg.literal = !has_wildcards(text);
+      if (!seg.literal) literal = false;
+      segments.push_back(std::move(seg));
+    }
+
+    // Base directory: the leading literal segments (all but the file name for literal patterns)
+    std::string base_text;
+    for (std::size_t i = 0; i < segments.size(); ++i) {
+      if (!segments[i].literal || (literal && i + 1 == segments.size())) break;
+      base_text += segments[i].text;
+      base_text += '/';
+    }
+    base = base_text;
+  }
+
+  bool glob::matches(const path& p) const {
+    const std::string text = p.generic_string();
+    return match_from(0, text, !text.empty(), false);
+  }
+
+  bool glob::may_match_below(const path& dir) const {
+    const std::string text = dir.generic_string();
+    return match_from(0, text, !text.empty(), true);
+  }
+
+  bool glob::matches_all_below(const path& dir) const {
+    return !segments.empty() && segments.back().any_directories && matches(dir);
+  }
+
+  const path& glob::get_base() const {
+    return base;
+  }
+
+  bool glob::is_literal() const {
+    return literal;
+  }
+
+  bool glob::match_from(std::size_t index, std::string_view rest, bool more, bool prefix) const {
+    // Doubled '/' inside the path are skipped, like empty segments of the pattern
+    if (index > 0) {
+      while (!rest.empty() && rest.front() == '/') rest.remove_prefix(1);
+      more = more && !rest.empty();
+    }
+
+    if (index == segments.size()) return !more;
+    if (!more) {
+      // Out of path: a directory prefix can still lead to a match; a full path
+      // matches only if every remaining segment is "**"
+      if (prefix) return true;
+      return std::all_of(segments.begin() + static_cast<std::ptrdiff_t>(index), segments.end(),
+                         [](const segment& seg) { return seg.any_directories; });
+    }
+
+    const segment& seg = segments[index];
+    std::string_view tail = rest;
+    bool tail_more = more;
+    const std::string_view name = next_segment(tail, tail_more);
+
+    if (seg.any_directories) {
+      return match_from(index + 1, rest, more, prefix) || match_from(index, tail, tail_more, prefix);
+    }
+    if (seg.literal ? name != seg.text : !match_segment(seg.text, name)) return false;
+    return match_from(index + 1, tail, tail_more, prefix);
+  }
+
+  // =============================================================================
+  // manifest
+  // =============================================================================
+
+  namespace {
+
+    constexpr char manifest_magic[8] = {'X', 'C', 'C', 'M', 'M', 'A', 'N', 'F'};
+    constexpr std::uint32_t manifest_version = 1;
+
+    unsigned resolve_thread_count(unsigned requested) {
+      return requested == 0 ? std::max(1u, std::thread::hardware_concurrency()) : requested;
+    }
+
+    // Manifests store integers little-endian, whatever the host byte order
+    void put_uint(std::string& out, std::uint64_t value, int bytes) {
+      for (int i = 0; i < bytes; ++i) out.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+    }
+
+    std::uint64_t load_le64(const unsigned char* p) {
+      std::uint64_t value = 0;
+      for (int i = 0; i < 8; ++i) value |= std::uint64_t {p[i]} << (8 * i);
+      return value;
+    }
+
+    class manifest_reader {
+     public:
+      explicit manifest_reader(std::string_view data): rest(data) {}
+
+      bool get_uint(std::uint64_t& value, int bytes) {
+        if (rest.size() < static_cast<std::size_t>(bytes)) return false;
+        value = 0;
+        for (int i = 0; i < bytes; ++i) value |= std::uint64_t {static_cast<unsigned char>(rest[i])} << (8 * i);
+        rest.remove_prefix(bytes);
+        return true;
+      }
+
+      bool get_bytes(std::string_view& value, std::size_t count) {
+        if (rest.size() < count) return false;
+        value = rest.substr(0, count);
+        rest.remove_prefix(count);
+        return true;
+      }
+
+      bool at_end() const { return rest.empty(); }
+
+     private:
+      std::string_view rest;
+    };
+
+    bool stat_file(const path& file_path, manifest::entry& out) {
+#if defined(XCCMETA_HAS_POSIX_IO)
+      struct stat info {};
+      if (::stat(file_path.c_str(), &info) != 0 || !S_ISREG(info.st_mode)) {
+        return false;
+      }
+#  if defined(__APPLE__)
+      const auto& modified = info.st_mtimespec;
+#  else
+      const auto& modified = info.st_mtim;
+#  endif
+      out.size = static_cast<std::uint64_t>(info.st_size);
+      out.mtime = static_cast<std::int64_t>(modified.tv_sec) * 1000000000 + modified.tv_nsec;
+      out.inode = static_cast<std::uint64_t>(info.st_ino);
+#else
+      std::error_code ec;
+      if (!std::filesystem::is_regular_file(file_path, ec)) {
+        return false;
+      }
+      const auto size = std::filesystem::file_size(file_path, ec);
+      if (ec) return false;
+      const auto modified = std::filesystem::last_write_time(file_path, ec);
+      if (ec) return false;
+      out.size = size;
+      out.mtime = std::chrono::duration_cast<std::chrono::nanoseconds>(modified.time_since_epoch()).count();
+      out.inode = 0;
+#endif
+      return true;
+    }
+
+    bool scan_file(const file& f, const manifest* previous, manifest::entry& out) {
+      out.file_path = f.get_path();
+      if (!stat_file(out.file_path, out)) {
+        return false;
+      }
+
+      // Unchanged metadata: trust the previous hash instead of reading the file
+      if (previous) {
+        const manifest::entry* old = previous->find(out.file_path);
+        if (old && old->size == out.size && old->mtime == out.mtime && old->inode == out.inode) {
+          out.hash = old->hash;
+          return true;
+        }
+      }
+
+      const mapped_file content = f.map();
+      if (!content.is_valid()) {
+        return false;
+      }
+      out.hash = manifest::hash_content(content.view());
+      return true;
+    }
+
+  }  // namespace
+
+  bool manifest::changes::empty() const {
+    return changed.empty() && added.empty() && removed.empty();
+  }
+
+  manifest manifest::scan(const std::vector<file>& files, const manifest* previous, unsigned thread_count) {
+    std::vector<entry> scanned(files.size());
+    std::vector<char> ok(files.size(), 0);  // char, not bool: written concurrently
+
+    std::atomic<std::size_t> next {0};
+    auto work = [&] {
+      for (std::size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < files.size();) {
+        ok[i] = scan_file(files[i], previous, scanned[i]);
+      }
+    };
+
+    const std::size_t workers = std::min<std::size_t>(resolve_thread_count(thread_count), files.size());
+    if (workers <= 1) {
+      work();
+    } else {
+      std::vector<std::thread> threads;
+      threads.reserve(workers);
+      for (std::size_t t = 0; t < workers; ++t) threads.emplace_back(work);
+      for (auto& t : threads) t.join();
+    }
+
+    manifest result;
+    result.entries.reserve(files.size());
+    for (std::size_t i = 0; i < files.size(); ++i) {
+      if (ok[i]) result.entries.push_back(std::move(scanned[i]));
+    }
+
+    auto by_path = [](const entry& a, const entry& b) { return a.file_path < b.file_path; };
+    auto same_path = [](const entry& a, const entry& b) { return a.file_path == b.file_path; };
+    std::sort(result.entries.begin(), result.entries.end(), by_path);
+    result.entries.erase(std::unique(result.entries.begin(), result.entries.end(), same_path),
+                         result.entries.end());
+    return result;
+  }
+
+  std::uint64_t manifest::hash_content(std::string_view content) {
+    constexpr std::uint64_t k0 = 0x9e3779b97f4a7c15ull;
+    constexpr std::uint64_t k1 = 0xbf58476d1ce4e5b9ull;
+    constexpr std::uint64_t k2 = 0x94d049bb133111ebull;
+    auto round = [](std::uint64_t acc, std::uint64_t word) { return std::rotl(acc + word * k2, 31) * k1; };
+
+    const auto* p = reinterpret_cast<const unsigned char*>(content.data());
+    std::size_t n = content.size();
+    std::uint64_t h = k0 ^ n;
+
+    // Four independent lanes over 32-byte blocks keep several multiplies in flight
+    if (n >= 32) {
+      std::uint64_t lanes[4] = {k0, k1, k2, k0 ^ k1};
+      for (; n >= 32; p += 32, n -= 32) {
+        for (int i = 0; i < 4; ++i) lanes[i] = round(lanes[i], load_le64(p + 8 * i));
+      }
+      h ^= std::rotl(lanes[0], 1) + std::rotl(lanes[1], 7) + std::rotl(lanes[2], 12) + std::rotl(lanes[3], 18);
+    }
+    for (; n >= 8; p += 8, n -= 8) {
+      h = std::rotl(h ^ round(0, load_le64(p)), 27) * k1 + k2;
+    }
+    for (; n > 0; ++p, --n) {
+      h = std::rotl(h ^ (*p * k0), 11) * k1;
+    }
+
+    h = (h ^ (h >> 30)) * k1;  // splitmix64 finalizer
+    h = (h ^ (h >> 27)) * k2;
+    return h ^ (h >> 31);
+  }
+
+  bool manifest::load(const path& manifest_path) {
+    entries.clear();
+
+    std::string data;
+    if (!read_whole(manifest_path, data)) {
+      return false;
+    }
+
+    manifest_reader in(data);
+    std::string_view magic;
+    std::uint64_t version = 0;
+    std::uint64_t count = 0;
+    if (!in.get_bytes(magic, sizeof(manifest_magic)) ||
+        std::memcmp(magic.data(), manifest_magic, sizeof(manifest_magic)) != 0 || !in.get_uint(version, 4) ||
+        version != manifest_version || !in.get_uint(count, 8)) {
+      return false;
+    }
+
+    std::vector<entry> loaded;
+    for (std::uint64_t i = 0; i < count; ++i) {
+      entry e;
+      std::uint64_t path_length = 0;
+      std::uint64_t mtime = 0;
+      std::string_view path_text;
+      if (!in.get_uint(path_length, 4) || !in.get_bytes(path_text, path_length) || !in.get_uint(e.size, 8) ||
+          !in.get_uint(mtime, 8) || !in.get_uint(e.inode, 8) || !in.get_uint(e.hash, 8)) {
+        return false;
+      }
+      e.file_path = path(path_text);
+      e.mtime = static_cast<std::int64_t>(mtime);
+      // Sorted on save; anything else means the file was not written by us
+      if (!loaded.empty() && !(loaded.back().file_path < e.file_path)) {
+        return false;
+      }
+      loaded.push_back(std::move(e));
+    }
+    if (!in.at_end()) {
+      return false;
+    }
+
+    entries = std::move(loaded);
+    return true;
+  }
+
+  bool manifest::save(const path& manifest_path) const {
+    std::string data(manifest_magic, sizeof(manifest_magic));
+    put_uint(data, manifest_version, 4);
+    put_uint(data, entries.size(), 8);
+    for (const auto& e : entries) {
+      const std::string path_text = e.file_path.generic_string();
+      put_uint(data, path_text.size(), 4);
+      data += path_text;
+      put_uint(data, e.size, 8);
+      put_uint(data, static_cast<std::uint64_t>(e.mtime), 8);
+      put_uint(data, e.inode, 8);
+      put_uint(data, e.hash, 8);
+    }
+
+    // Write beside the target and rename over it, so a crash never leaves a torn manifest
+    path temp_path = manifest_path;
+    temp_path += ".tmp";
+    {
+      std::ofstream out(temp_path, std::ios::out | std::ios::binary | std::ios::trunc);
+      if (!out || !out.write(data.data(), static_cast<std::streamsize>(data.size()))) {
+        return false;
+      }
+    }
+    std::error_code ec;
+    std::filesystem::rename(temp_path, manifest_path, ec);
+    if (ec) {
+      std::filesystem::remove(temp_path, ec);
+      return false;
+    }
+    return true;
+  }
+
+  manifest::changes manifest::diff(const manifest& previous) const {
+    changes result;
+    auto now = entries.begin();
+    auto before = previous.entries.begin();
+    while (now != entries.end() || before != previous.entries.end()) {
+      if (before == previous.entries.end() || (now != entries.end() && now->file_path < before->file_path)) {
+        result.added.emplace_back(now->file_path);
+        ++now;
+      } else if (now == entries.end() || before->file_path < now->file_path) {
+        result.removed.push_back(before->file_path);
+        ++before;
+      } else {
+        if (now->size != before->size || now->hash != before->hash) {
+          result.changed.emplace_back(now->file_path);
+        }
+        ++now;
+        ++before;
+      }
+    }
+    return result;
+  }
+
+  manifest manifest::select(const std::vector<file>& files) const {
+    manifest result;
+    for (const auto& f : files) {
+      if (const entry* e = find(f.get_path())) result.entries.push_back(*e);
+    }
+    auto by_path = [](const entry& a, const entry& b) { return a.file_path < b.file_path; };
+    auto same_path = [](const entry& a, const entry& b) { return a.file_path == b.file_path; };
+    std::sort(result.entries.begin(), result.entries.end(), by_path);
+    result.entries.erase(std::unique(result.entries.begin(), result.entries.end(), same_path),
+                         result.entries.end());
+    return result;
+  }
+
+  void manifest::merge(const manifest& other) {
+    std::vector<entry> merged;
+    merged.reserve(entries.size() + other.entries.size());
+    auto mine = entries.begin();
+    auto theirs = other.entries.begin();
+    while (mine != entries.end() || theirs != other.entries.end()) {
+      if (theirs == other.entries.end() || (mine != entries.end() && mine->file_path < theirs->file_path)) {
+        merged.push_back(std::move(*mine++));
+      } else {
+        if (mine != entries.end() && mine->file_path == theirs->file_path) ++mine;
+        merged.push_back(*theirs++);
+      }
+    }
+    entries = std::move(merged);
+  }
+
+  const std::vector<manifest::entry>& manifest::get_entries() const {
+    return entries;
+  }
+
+  const manifest::entry* manifest::find(const path& file_path) const {
+    auto it = std::lower_bound(entries.begin(), entries.end(), file_path,
+                               [](const entry& e, const path& p) { return e.file_path < p; });
+    return it != entries.end() && it->file_path == file_path ? &*it : nullptr;
+  }
+
+  // =============================================================================
+  // importer
+  // =============================================================================
+
+  namespace {
+
+    // Lists directories from a shared queue on several threads; each worker keeps
+    // its own matches, which are merged and sorted by the caller
+    class directory_walker {
+     public:
+      directory_walker(const std::vector<glob>& includes, const std::vector<glob>& excludes)
+          : includes(includes), excludes(excludes) {}
+
+      std::vector<path> run(const std::vector<path>& roots, unsigned thread_count) {
+        for (const auto& root : roots) queue.push_back(root);
+
+        std::vector<std::vector<path>> found(std::max(1u, thread_count));
+        if (found.size() == 1) {
+          work(found[0]);
+        } else {
+          std::vector<std::thread> threads;
+          threads.reserve(found.size());
+          for (auto& out : found) threads.emplace_back([this, &out] { work(out); });
+          for (auto& t : threads) t.join();
+        }
+
+        std::vector<path> result;
+        for (auto& part : found) result.insert(result.end(), part.begin(), part.end());
+        return result;
+      }
+
+     private:
+      void work(std::vector<path>& out) {
+        std::vector<path> subdirs;
+        for (;;) {
+          path dir;
+          {
+            std::unique_lock lock(mutex);
+            ready.wait(lock, [this] { return !queue.empty() || active == 0; });
+            if (queue.empty()) return;  // Nothing queued and nobody can queue more
+            dir = std::move(queue.front());
+            queue.pop_front();
+            active++;
+          }
+
+          list(dir, out, subdirs);
+
+          {
+            std::lock_guard lock(mutex);
+            for (auto& sub : subdirs) queue.push_back(std::move(sub));
+            active--;
+          }
+          subdirs.clear();
+          ready.notify_all();
+        }
+      }
+
+      void list(const path& dir, std::vector<path>& out, std::vector<path>& subdirs) const {
+        std::error_code ec;
+        std::filesystem::directory_iterator it(dir.empty() ? path(".") : dir, ec);
+        for (; !ec && it != std::filesystem::directory_iterator(); it.increment(ec)) {
+          const auto& entry = *it;
+          path child = dir / entry.path().filename();
 
-    for (const auto& entry : std::filesystem::directory_iterator(base_path)) {
-      if (entry.is_regular_file()) {
-        if (std::filesystem::path(entry.path()).filename().string() == pattern ||
-            pattern == "*") {
-          files.emplace_back(entry.path());
+          std::error_code status_ec;
+          // Symlinked directories are not followed, so links cannot create cycles
+          if (entry.is_directory(status_ec) && !entry.is_symlink(status_ec)) {
+            const bool wanted = std::any_of(includes.begin(), includes.end(),
+                                            [&](const glob& g) { return g.may_match_below(child); });
+            const bool pruned = std::any_of(excludes.begin(), excludes.end(),
+                                            [&](const glob& g) { return g.matches_all_below(child); });
+            if (wanted && !pruned) subdirs.push_back(std::move(child));
+          } else if (entry.is_regular_file(status_ec)) {
+            if (std::any_of(includes.begin(), includes.end(), [&](const glob& g) { return g.matches(child); }) &&
+                std::none_of(excludes.begin(), excludes.end(), [&](const glob& g) { return g.matches(child); })) {
+              out.push_back(std::move(child));
+            }
+          }
         }
       }
+
+      const std::vector<glob>& includes;
+      const std::vector<glob>& excludes;
+      std::mutex mutex;
+      std::condition_variable ready;
+      std::deque<path> queue;
+      std::size_t active = 0;  // Directories being listed
+    };
+
+    importer::config single_pattern(const std::string& wildcard) {
+      importer::config cfg;
+      cfg.patterns.push_back(wildcard);
+      return cfg;
+    }
+
+  }  // namespace
+
+  importer::importer(const std::string& wildcard): importer(single_pattern(wildcard)) {
+  }
+
+  importer::importer(const config& cfg) {
+    std::vector<glob> includes(cfg.patterns.begin(), cfg.patterns.end());
+    std::vector<glob> excludes(cfg.exclude_patterns.begin(), cfg.exclude_patterns.end());
+    auto excluded = [&](const path& p) {
+      return std::any_of(excludes.begin(), excludes.end(), [&](const glob& g) { return g.matches(p); });
+    };
+
+    std::vector<path> found;
+    std::vector<glob> walked;
+    std::vector<std::string> roots;
+    for (std::size_t i = 0; i < includes.size(); ++i) {
+      if (includes[i].is_literal()) {
+        // A plain file path needs no directory walk
+        path p(cfg.patterns[i]);
+        std::error_code ec;
+        if (std::filesystem::is_regular_file(p, ec) && !excluded(p)) found.push_back(p);
+      } else {
+        walked.push_back(includes[i]);
+        roots.push_back(includes[i].get_base().generic_string());
+      }
+    }
+
+    // A root inside another root is reached by the outer walk anyway. Bases end
+    // in '/', so a string prefix is a directory prefix ("" holds every relative path).
+    std::sort(roots.begin(), roots.end());
+    std::vector<path> walk_roots;
+    for (const auto& root : roots) {
+      if (!walk_roots.empty()) {
+        const std::string outer = walk_roots.back().generic_string();
+        if (outer.empty() ? path(root).is_relative() : root.compare(0, outer.size(), outer) == 0) continue;
+      }
+      walk_roots.emplace_back(root);
+    }
+
+    const unsigned thread_count = resolve_thread_count(cfg.thread_count);
+    std::vector<path> listed = directory_walker(walked, excludes).run(walk_roots, thread_count);
+    found.insert(found.end(), listed.begin(), listed.end());
+
+    std::sort(found.begin(), found.end());
+    found.erase(std::unique(found.begin(), found.end()), found.end());
+    files.reserve(found.size());
+    for (auto& p : found) files.emplace_back(p);
+
+    manifest_path = cfg.manifest_path;
+    if (manifest_path.empty()) {
+      return;
+    }
+
+    manifest previous;
+    previous.load(manifest_path);  // A missing manifest makes every file added
+    current = manifest::scan(files, &previous, thread_count);
+    changes = current.diff(previous);
+
+    if (cfg.only_changed) {
+      files.clear();
+      std::merge(changes.changed.begin(), changes.changed.end(), changes.added.begin(), changes.added.end(),
+                 std::back_inserter(files),
+                 [](const file& a, const file& b) { return a.get_path() < b.get_path(); });
     }
   }
 
@@ -81,4 +867,19 @@ namespace xccmeta {
     return files;
   }
 
+  const manifest& importer::get_manifest() const {
+    return current;
+  }
+
+  const manifest::changes& importer::get_changes() const {
+    return changes;
+  }
+
+  bool importer::save_manifest() const {
+    if (manifest_path.empty()) {
+      return false;
+    }
+    return current.save(manifest_path);
+  }
+
 }  // namespace xccmeta
\ No newline at end of file
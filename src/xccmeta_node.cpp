@@ -28,6 +28,18 @@ SOFTWARE.
 
 namespace xccmeta {
 
+  // Resolve tag names to interned ids once per query; names that were never
+  // interned cannot be present on any node and are dropped.
+  static std::vector<tag_id> lookup_tag_ids(const std::vector<std::string>& names) {
+    std::vector<tag_id> ids;
+    ids.reserve(names.size());
+    for (const auto& name : names) {
+      tag_id id = tag::lookup(name);
+      if (id != tag::invalid_id) ids.push_back(id);
+    }
+    return ids;
+  }
+
   node::node(node::private_key, kind k): kind_(k) {
   }
 
@@ -76,30 +88,60 @@ namespace xccmeta {
   }
 
   bool node::has_tag(const std::string& name) const {
-    return std::any_of(tags_.begin(), tags_.end(), [&name](const tag& t) { return t.get_name() == name; });
+    return has_tag(tag::lookup(name));
+  }
+
+  bool node::has_tag(tag_id id) const {
+    // The mask rejects most misses with a single bit test
+    if ((tag_mask_ & tag::mask_of(id)) == 0) return false;
+    return std::any_of(tags_.begin(), tags_.end(), [id](const tag& t) { return t.get_id() == id; });
   }
 
   bool node::has_tags(const std::vector<std::string>& names) const {
+    if (tags_.empty()) return false;
     for (const auto& name : names) {
-      if (has_tag(name)) return true;
+      if (has_tag(tag::lookup(name))) return true;
+    }
+    return false;
+  }
+
+  bool node::has_tag_ids(const std::vector<tag_id>& ids) const {
+    if (tags_.empty()) return false;
+    for (tag_id id : ids) {
+      if (has_tag(id)) return true;
     }
     return false;
   }
 
   std::optional<tag> node::find_tag(const std::string& name) const {
-    auto it = std::find_if(tags_.begin(), tags_.end(), [&name](const tag& t) { return t.get_name() == name; });
+    return find_tag(tag::lookup(name));
+  }
+
+  std::optional<tag> node::find_tag(tag_id id) const {
+    if ((tag_mask_ & tag::mask_of(id)) == 0) return std::nullopt;
+    auto it = std::find_if(tags_.begin(), tags_.end(), [id](const tag& t) { return t.get_id() == id; });
     if (it != tags_.end()) return *it;
     return std::nullopt;
   }
 
   std::vector<tag> node::find_tags(const std::vector<std::string>& names) const {
     std::vector<tag> result;
+    if (tags_.empty()) return result;
+
+    std::vector<tag_id> ids;
+    std::uint64_t mask = 0;
+    ids.reserve(names.size());
+    for (const auto& name : names) {
+      tag_id id = tag::lookup(name);
+      if (id == tag::invalid_id) continue;
+      ids.push_back(id);
+      mask |= tag::mask_of(id);
+    }
+    if ((tag_mask_ & mask) == 0) return result;
+
     for (const auto& t : tags_) {
-      for (const auto& name : names) {
-        if (t.get_name() == name) {
-          result.push_back(t);
-          break;
-        }
+      if (std::find(ids.begin(), ids.end(), t.get_id()) != ids.end()) {
+        result.push_back(t);
       }
     }
     return result;
@@ -108,21 +150,95 @@ namespace xccmeta {
   void node::add_child(node_ptr child) {
     if (child) {
       child->parent_ = shared_from_this();
+      child->invalidate_tag_cache();
+
+      // Insert after the last child of the same bucket to keep source order within it
+      const int bucket = kind_bucket(child->get_kind());
+      auto pos = std::upper_bound(children_by_kind_.begin(), children_by_kind_.end(), bucket,
+                                  [](int b, const node_ptr& n) { return b < kind_bucket(n->get_kind()); });
+      children_by_kind_.insert(pos, child);
+      children_.push_back(std::move(child));
+    }
+  }
+
+  void node::add_children(std::vector<node_ptr> children) {
+    children_.reserve(children_.size() + children.size());
+    for (auto& child : children) {
+      if (!child) continue;
+      child->parent_ = shared_from_this();
+      child->invalidate_tag_cache();
       children_.push_back(std::move(child));
     }
+
+    children_by_kind_ = children_;
+    std::stable_sort(children_by_kind_.begin(), children_by_kind_.end(), [](const node_ptr& a, const node_ptr& b) {
+      return kind_bucket(a->get_kind()) < kind_bucket(b->get_kind());
+    });
   }
 
   void node::remove_child(const node_ptr& child) {
     auto it = std::find(children_.begin(), children_.end(), child);
     if (it != children_.end()) {
-      (*it)->parent_.reset();
+      if (!(*it)->shared_) {
+        (*it)->parent_.reset();
+        (*it)->invalidate_tag_cache();
+      }
+      children_by_kind_.erase(std::find(children_by_kind_.begin(), children_by_kind_.end(), child));
       children_.erase(it);
     }
   }
 
+  void node::share_child(std::size_t index, node_ptr child) {
+    if (index >= children_.size() || !child) return;
+    if (!child->shared_) {
+      // Holders share the inherited tags (the pool only shares between equal
+      // contexts), so they are computed once here and kept; a parent link would
+      // point into just one of the trees
+      child->get_all_tags_view();
+      child->parent_.reset();
+      child->shared_ = true;
+    }
+    // Same kind as the replaced child, so its slot in the kind index stays valid
+    *std::find(children_by_kind_.begin(), children_by_kind_.end(), children_[index]) = child;
+    children_[index] = std::move(child);
+  }
+
+  std::vector<node_ptr> node::release_children() {
+    for (const auto& child : children_) {
+      if (child->shared_) continue;  // Other trees still hold it
+      child->parent_.reset();
+      child->invalidate_tag_cache();
+    }
+    children_by_kind_.clear();
+    std::vector<node_ptr> released;
+    released.swap(children_);
+    return released;
+  }
+
+  int node::kind_bucket(kind k) {
+    switch (k) {
+      case kind::constructor_decl:
+      case kind::destructor_decl:
+      case kind::conversion_decl:
+        return static_cast<int>(kind::method_decl);
+      default:
+        return static_cast<int>(k);
+    }
+  }
+
+  std::span<const node_ptr> node::get_children_in_bucket(kind k) const {
+    const int bucket = kind_bucket(k);
+    auto first = std::lower_bound(children_by_kind_.begin(), children_by_kind_.end(), bucket,
+                                  [](const node_ptr& n, int b) { return kind_bucket(n->get_kind()) < b; });
+    auto last = std::upper_bound(first, children_by_kind_.end(), bucket,
+                                 [](int b, const node_ptr& n) { return b < kind_bucket(n->get_kind()); });
+    return std::span<const node_ptr>(children_by_kind_.data() + (first - children_by_kind_.begin()),
+                                     static_cast<std::size_t>(last - first));
+  }
+
   std::vector<node_ptr> node::get_children_by_kind(kind k) const {
     std::vector<node_ptr> result;
-    for (const auto& child : children_) {
+    for (const auto& child : get_children_in_bucket(k)) {
       if (child->get_kind() == k) result.push_back(child);
     }
     return result;
@@ -174,33 +290,24 @@ namespace xccmeta {
     }
   }
 
-  std::vector<node_ptr> node::get_bases() const {
-    return get_children_by_kind(kind::base_specifier);
+  std::span<const node_ptr> node::get_bases() const {
+    return get_children_in_bucket(kind::base_specifier);
   }
 
-  std::vector<node_ptr> node::get_methods() const {
-    std::vector<node_ptr> result;
-    for (const auto& child : children_) {
-      if (child->get_kind() == kind::method_decl ||
-          child->get_kind() == kind::constructor_decl ||
-          child->get_kind() == kind::destructor_decl ||
-          child->get_kind() == kind::conversion_decl) {
-        result.push_back(child);
-      }
-    }
-    return result;
+  std::span<const node_ptr> node::get_methods() const {
+    return get_children_in_bucket(kind::method_decl);
   }
 
-  std::vector<node_ptr> node::get_fields() const {
-    return get_children_by_kind(kind::field_decl);
+  std::span<const node_ptr> node::get_fields() const {
+    return get_children_in_bucket(kind::field_decl);
   }
 
-  std::vector<node_ptr> node::get_parameters() const {
-    return get_children_by_kind(kind::parameter_decl);
+  std::span<const node_ptr> node::get_parameters() const {
+    return get_children_in_bucket(kind::parameter_decl);
   }
 
-  std::vector<node_ptr> node::get_enum_constants() const {
-    return get_children_by_kind(kind::enum_constant_decl);
+  std::span<const node_ptr> node::get_enum_constants() const {
+    return get_children_in_bucket(kind::enum_constant_decl);
   }
 
   // =============================================================================
@@ -209,8 +316,9 @@ namespace xccmeta {
 
   std::vector<node_ptr> node::get_children_by_tag(const std::string& tag_name) const {
     std::vector<node_ptr> result;
+    tag_id id = tag::lookup(tag_name);
     for (const auto& child : children_) {
-      if (child->has_tag(tag_name)) {
+      if (child->has_tag(id)) {
         result.push_back(child);
       }
     }
@@ -219,12 +327,10 @@ namespace xccmeta {
 
   std::vector<node_ptr> node::get_children_by_tags(const std::vector<std::string>& tag_names) const {
     std::vector<node_ptr> result;
+    std::vector<tag_id> ids = lookup_tag_ids(tag_names);
     for (const auto& child : children_) {
-      for (const auto& tag_name : tag_names) {
-        if (child->has_tag(tag_name)) {
-          result.push_back(child);
-          break;  // Don't add the same child multiple times
-        }
+      if (child->has_tag_ids(ids)) {
+        result.push_back(child);
       }
     }
     return result;
@@ -232,8 +338,9 @@ namespace xccmeta {
 
   std::vector<node_ptr> node::get_children_without_tag(const std::string& tag_name) const {
     std::vector<node_ptr> result;
+    tag_id id = tag::lookup(tag_name);
     for (const auto& child : children_) {
-      if (!child->has_tag(tag_name)) {
+      if (!child->has_tag(id)) {
         result.push_back(child);
       }
     }
@@ -242,8 +349,9 @@ namespace xccmeta {
 
   std::vector<node_ptr> node::get_children_without_tags(const std::vector<std::string>& tag_names) const {
     std::vector<node_ptr> result;
+    std::vector<tag_id> ids = lookup_tag_ids(tag_names);
     for (const auto& child : children_) {
-      if (!child->has_tags(tag_names)) {
+      if (!child->has_tag_ids(ids)) {
         result.push_back(child);
       }
     }
@@ -251,8 +359,9 @@ namespace xccmeta {
   }
 
   node_ptr node::find_child_with_tag(const std::string& tag_name) const {
+    tag_id id = tag::lookup(tag_name);
     for (const auto& child : children_) {
-      if (child->has_tag(tag_name)) {
+      if (child->has_tag(id)) {
         return child;
       }
     }
@@ -260,8 +369,9 @@ namespace xccmeta {
   }
 
   node_ptr node::find_child_with_tags(const std::vector<std::string>& tag_names) const {
+    std::vector<tag_id> ids = lookup_tag_ids(tag_names);
     for (const auto& child : children_) {
-      if (child->has_tags(tag_names)) {
+      if (child->has_tag_ids(ids)) {
         return child;
       }
     }
@@ -269,8 +379,9 @@ namespace xccmeta {
   }
 
   node_ptr node::find_child_without_tag(const std::string& tag_name) const {
+    tag_id id = tag::lookup(tag_name);
     for (const auto& child : children_) {
-      if (!child->has_tag(tag_name)) {
+      if (!child->has_tag(id)) {
         return child;
       }
     }
@@ -278,8 +389,9 @@ namespace xccmeta {
   }
 
   node_ptr node::find_child_without_tags(const std::vector<std::string>& tag_names) const {
+    std::vector<tag_id> ids = lookup_tag_ids(tag_names);
     for (const auto& child : children_) {
-      if (!child->has_tags(tag_names)) {
+      if (!child->has_tag_ids(ids)) {
         return child;
       }
     }
@@ -291,21 +403,181 @@ namespace xccmeta {
   // =============================================================================
 
   std::vector<tag> node::get_parent_tags() const {
-    std::vector<tag> result;
+    auto view = get_parent_tags_view();
+    return std::vector<tag>(view.begin(), view.end());
+  }
+
+  std::vector<tag> node::get_all_tags() const {
+    auto view = get_all_tags_view();
+    return std::vector<tag>(view.begin(), view.end());
+  }
+
+  std::span<const tag> node::get_parent_tags_view() const {
+    if (!parent_tags_cache_) build_tag_cache();
+    return *parent_tags_cache_;
+  }
+
+  std::span<const tag> node::get_all_tags_view() const {
+    if (!all_tags_cache_) build_tag_cache();
+    return *all_tags_cache_;
+  }
+
+  void node::build_tag_cache() const {
+    static const tag_list_ptr empty = std::make_shared<const std::vector<tag>>();
+
+    // A node's inherited tags are exactly its parent's "all tags", so every
+    // child of a parent points at the same list.
     node_ptr parent = parent_.lock();
-    while (parent) {
-      const auto& parent_tags = parent->get_tags();
-      result.insert(result.end(), parent_tags.begin(), parent_tags.end());
-      parent = parent->get_parent();
+    if (parent) {
+      if (!parent->all_tags_cache_) parent->build_tag_cache();
+      parent_tags_cache_ = parent->all_tags_cache_;
+    } else {
+      parent_tags_cache_ = empty;
+    }
+
+    if (tags_.empty()) {
+      all_tags_cache_ = parent_tags_cache_;
+    } else {
+      auto all = std::make_shared<std::vector<tag>>();
+      all->reserve(tags_.size() + parent_tags_cache_->size());
+      all->insert(all->end(), tags_.begin(), tags_.end());
+      all->insert(all->end(), parent_tags_cache_->begin(), parent_tags_cache_->end());
+      all_tags_cache_ = std::move(all);
     }
-    return result;
   }
 
-  std::vector<tag> node::get_all_tags() const {
-    std::vector<tag> result = tags_;  // Start with own tags
-    std::vector<tag> parent_tags = get_parent_tags();
-    result.insert(result.end(), parent_tags.begin(), parent_tags.end());
-    return result;
+  void node::invalidate_tag_cache() {
+    // A cached node always has cached ancestors, so the walk can stop at the
+    // first node without a cache.
+    if (!all_tags_cache_) return;
+    parent_tags_cache_.reset();
+    all_tags_cache_.reset();
+    for (const auto& child : children_) {
+      if (!child->shared_) child->invalidate_tag_cache();  // Shared nodes keep their pinned tags
+    }
+  }
+
+  // =============================================================================
+  // Structural hashing
+  // =============================================================================
+
+  namespace {
+
+    // Fixed algorithms (not std::hash) so hashes are stable across runs and platforms
+    class hasher {
+     public:
+      void add(std::uint64_t v) {
+        h_ ^= v + 0x9e3779b97f4a7c15ull + (h_ << 6) + (h_ >> 2);
+      }
+      void add(bool v) { add(std::uint64_t {v}); }
+      void add(std::int64_t v) { add(static_cast<std::uint64_t>(v)); }
+      void add(const std::string& s) {
+        std::uint64_t h = 0xcbf29ce484222325ull;  // FNV-1a
+        for (unsigned char c : s) {
+          h ^= c;
+          h *= 0x100000001b3ull;
+        }
+        add(h);
+        add(std::uint64_t {s.size()});
+      }
+
+      std::uint64_t finish() const {
+        std::uint64_t z = h_;  // splitmix64 finalizer
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+      }
+
+     private:
+      std::uint64_t h_ = 0;
+    };
+
+    void hash_type(hasher& h, const type_info& t) {
+      h.add(t.get_spelling());
+      h.add(t.get_canonical());
+      h.add(t.get_declaration_usr());
+      std::uint64_t flags = 0;
+      for (bool b : {t.is_const(), t.is_volatile(), t.is_restrict(), t.is_pointer(), t.is_lvalue_reference(),
+                     t.is_rvalue_reference(), t.is_array(), t.is_function_pointer()}) {
+        flags = (flags << 1) | (b ? 1 : 0);
+      }
+      h.add(flags);
+      h.add(t.get_array_size());
+      h.add(t.get_size_bytes());
+      h.add(t.get_alignment());
+    }
+
+    void hash_location(hasher& h, const source_location& loc) {
+      h.add(loc.file);
+      h.add(std::uint64_t {loc.line});
+      h.add(std::uint64_t {loc.column});
+      h.add(std::uint64_t {loc.offset});
+    }
+
+  }  // namespace
+
+  void node::update_hashes() {
+    // Iterative post-order so deep trees cannot overflow the stack
+    std::vector<std::pair<node*, std::size_t>> stack {{this, 0}};
+    while (!stack.empty()) {
+      auto& [n, next] = stack.back();
+      if (next < n->children_.size()) {
+        node* child = n->children_[next++].get();
+        stack.push_back({child, 0});
+        continue;
+      }
+
+      hasher h;
+      h.add(static_cast<std::uint64_t>(n->kind_));
+      h.add(n->usr_);
+      h.add(n->name_);
+      h.add(n->qualified_name_);
+      h.add(n->display_name_);
+      h.add(n->mangled_name_);
+      hash_type(h, n->type_);
+      hash_type(h, n->return_type_);
+      h.add(static_cast<std::uint64_t>(n->access_));
+      h.add(static_cast<std::uint64_t>(n->storage_class_));
+
+      std::uint64_t flags = 0;
+      for (bool b : {n->is_definition_, n->is_virtual_, n->is_pure_virtual_, n->is_override_, n->is_final_,
+                     n->is_static_, n->is_const_method_, n->is_inline_, n->is_explicit_, n->is_constexpr_,
+                     n->is_noexcept_, n->is_deleted_, n->is_defaulted_, n->is_anonymous_, n->is_scoped_enum_,
+                     n->is_template_, n->is_template_spec_, n->is_variadic_, n->is_bitfield_,
+                     n->is_virtual_base_, n->has_default_value_}) {
+        flags = (flags << 1) | (b ? 1 : 0);
+      }
+      h.add(flags);
+      h.add(static_cast<std::int64_t>(n->bitfield_width_));
+      h.add(n->enum_value_);
+      h.add(n->default_value_);
+      h.add(n->underlying_type_);
+      h.add(n->comment_);
+      h.add(n->brief_comment_);
+
+      h.add(std::uint64_t {n->tags_.size()});
+      for (const auto& t : n->tags_) {
+        h.add(t.get_name());
+        h.add(std::uint64_t {t.get_args().size()});
+        for (const auto& arg : t.get_args()) h.add(arg);
+      }
+
+      hasher located = h;
+      hash_location(located, n->location_);
+      hash_location(located, n->extent_.start);
+      hash_location(located, n->extent_.end);
+
+      h.add(std::uint64_t {n->children_.size()});
+      located.add(std::uint64_t {n->children_.size()});
+      for (const auto& child : n->children_) {
+        h.add(child->hash_);
+        located.add(child->located_hash_);
+      }
+
+      n->hash_ = h.finish();
+      n->located_hash_ = located.finish();
+      stack.pop_back();
+    }
   }
 
   // =============================================================================
@@ -25,9 +25,11 @@ SOFTWARE.
 #include "xccmeta/xccmeta_parser.hpp"
 #include "libclang_include.h"
 
-#include <functional>
+#include <algorithm>
+#include <map>
+#include <string_view>
+#include <thread>
 #include <unordered_map>
-#include <unordered_set>
 
 namespace xccmeta {
 
@@ -143,6 +145,87 @@ namespace xccmeta {
       ti.set_size_bytes(size >= 0 ? size : -1);
       long long align = clang_Type_getAlignOf(cx_type);
       ti.set_alignment(align >= 0 ? align : -1);
+
+      // Referenced declarations
+      ti.set_declaration_usr(declaration_usr(clang_getCanonicalType(cx_type)));
+      collect_type_references(ti, cx_type);
+    }
+
+    // Strip pointers, references, arrays and elaboration down to the named type
+    static CXType strip_type(CXType t) {
+      for (;;) {
+        switch (t.kind) {
+          case CXType_Pointer:
+          case CXType_LValueReference:
+          case CXType_RValueReference:
+          case CXType_MemberPointer:
+            t = clang_getPointeeType(t);
+            break;
+          case CXType_ConstantArray:
+          case CXType_IncompleteArray:
+          case CXType_VariableArray:
+          case CXType_DependentSizedArray:
+            t = clang_getArrayElementType(t);
+            break;
+          case CXType_Elaborated:
+            t = clang_Type_getNamedType(t);
+            break;
+          default:
+            return t;
+        }
+      }
+    }
+
+    // USR of the declaration of a type's named part (empty for builtins)
+    static std::string declaration_usr(CXType t) {
+      CXCursor decl = clang_getTypeDeclaration(strip_type(t));
+      if (clang_Cursor_isNull(decl) || clang_getCursorKind(decl) == CXCursor_NoDeclFound) {
+        return {};
+      }
+      return cx_string_to_std(clang_getCursorUSR(decl));
+    }
+
+    // Collect the declarations a type mentions (see type_info::get_referenced_usrs)
+    static void collect_type_references(type_info& ti, CXType t) {
+      t = strip_type(t);
+
+      // Function types (function pointers, method types): signature
+      if (t.kind == CXType_FunctionProto || t.kind == CXType_FunctionNoProto) {
+        collect_type_references(ti, clang_getResultType(t));
+        int num_args = clang_getNumArgTypes(t);
+        for (int i = 0; i < num_args; ++i) {
+          collect_type_references(ti, clang_getArgType(t, static_cast<unsigned>(i)));
+        }
+        return;
+      }
+
+      CXCursor decl = clang_getTypeDeclaration(t);
+      if (!clang_Cursor_isNull(decl) && clang_getCursorKind(decl) != CXCursor_NoDeclFound) {
+        std::string usr = cx_string_to_std(clang_getCursorUSR(decl));
+        const auto& seen = ti.get_referenced_usrs();
+        if (!usr.empty() && std::find(seen.begin(), seen.end(), usr) != seen.end()) {
+          return;  // Already expanded
+        }
+        ti.add_referenced_usr(usr);
+
+        CXCursor primary = clang_getSpecializedCursorTemplate(decl);
+        if (!clang_Cursor_isNull(primary)) {
+          ti.add_referenced_usr(cx_string_to_std(clang_getCursorUSR(primary)));
+        }
+
+        CXCursorKind decl_kind = clang_getCursorKind(decl);
+        if (decl_kind == CXCursor_TypedefDecl || decl_kind == CXCursor_TypeAliasDecl) {
+          collect_type_references(ti, clang_getTypedefDeclUnderlyingType(decl));
+        }
+      }
+
+      int num_template_args = clang_Type_getNumTemplateArguments(t);
+      for (int i = 0; i < num_template_args; ++i) {
+        CXType arg = clang_Type_getTemplateArgumentAsType(t, static_cast<unsigned>(i));
+        if (arg.kind != CXType_Invalid) {
+          collect_type_references(ti, arg);
+        }
+      }
     }
 
     // Populate source_location from CXSourceLocation
@@ -413,6 +496,21 @@ namespace xccmeta {
 
     // Deep-clone a node and its children
     static node_ptr clone_node(const node_ptr& src) {
+      node_ptr copy = clone_shallow(src);
+      if (!copy) return nullptr;
+
+      for (const auto& child : src->get_children()) {
+        node_ptr child_copy = clone_node(child);
+        if (child_copy) {
+          copy->add_child(child_copy);
+        }
+      }
+
+      return copy;
+    }
+
+    // Clone a node without its children
+    static node_ptr clone_shallow(const node_ptr& src) {
       if (!src) return nullptr;
 
       node_ptr copy = node::create(src->get_kind());
@@ -459,22 +557,209 @@ namespace xccmeta {
         copy->add_tag(t);
       }
 
-      for (const auto& child : src->get_children()) {
-        node_ptr child_copy = clone_node(child);
-        if (child_copy) {
-          copy->add_child(child_copy);
+      return copy;
+    }
+
+    // Builds one translation unit out of the children of many roots. Namespaces
+    // and linkage specs reopened across (or within) inputs are unified into one
+    // node; other declarations are deduplicated by USR within the merged tree,
+    // keeping the first one unless a later one is a definition and it is not.
+    // Nodes without a USR are always kept.
+    class tree_merger {
+     public:
+      // move_nodes: take subtrees out of the inputs instead of cloning them
+      explicit tree_merger(bool move_nodes): move_nodes_(move_nodes) {
+        scopes_.push_back({node::create(node::kind::translation_unit), {}});
+        scopes_[0].node->set_name("merged");
+      }
+
+      void add_root(const node_ptr& root) {
+        if (!root) return;
+        for (const auto& child : children_of(root)) add(child, 0);
+      }
+
+      // finalize = false skips type linking and hashing, for partial results merged again later
+      node_ptr finish(bool finalize = true) {
+        for (auto& scope : scopes_) {
+          scope.node->add_children(std::move(scope.children));
+        }
+        node_ptr merged = scopes_[0].node;
+        if (finalize) {
+          link_type_declarations(merged);
+          merged->update_hashes();
         }
+        return merged;
       }
 
-      return copy;
+     private:
+      struct scope {
+        node_ptr node;
+        std::vector<node_ptr> children;  // Added to node by finish()
+      };
+      struct slot {
+        std::size_t scope;
+        std::size_t index;  // Into scopes_[scope].children
+      };
+
+      static bool is_container(const node_ptr& n) {
+        return n->get_kind() == node::kind::namespace_decl || n->get_kind() == node::kind::linkage_spec;
+      }
+
+      // Shared nodes (subtree_pool) belong to other trees as well, so they are
+      // cloned even when moving
+      bool can_move(const node_ptr& n) const { return move_nodes_ && !n->is_shared(); }
+      node_ptr take(const node_ptr& n) const { return can_move(n) ? n : clone_node(n); }
+
+      std::vector<node_ptr> children_of(const node_ptr& n) {
+        return can_move(n) ? n->release_children() : n->get_children();
+      }
+
+      void add(const node_ptr& n, std::size_t target) {
+        if (!n) return;
+
+        if (is_container(n)) {
+          add_container(n, target);
+          return;
+        }
+
+        const std::string& usr = n->get_usr();
+        if (usr.empty()) {
+          scopes_[target].children.push_back(take(n));
+          return;
+        }
+
+        auto it = by_usr_.find(usr);
+        if (it == by_usr_.end()) {
+          node_ptr taken = take(n);
+          by_usr_.emplace(taken->get_usr(), slot {target, scopes_[target].children.size()});
+          scopes_[target].children.push_back(std::move(taken));
+          return;
+        }
+
+        // Replace a forward declaration by a definition, in place
+        const slot at = it->second;
+        node_ptr& existing = scopes_[at.scope].children[at.index];
+        if (n->is_definition() && !existing->is_definition()) {
+          by_usr_.erase(it);  // The key views the node being replaced
+          existing = take(n);
+          by_usr_.emplace(existing->get_usr(), at);
+        }
+      }
+
+      void add_container(const node_ptr& n, std::size_t target) {
+        std::size_t inner;
+        const std::string& usr = n->get_usr();
+        if (!usr.empty()) {
+          auto it = container_by_usr_.find(usr);
+          if (it != container_by_usr_.end()) {
+            inner = it->second;
+          } else {
+            inner = open_scope(n, target);
+            container_by_usr_.emplace(scopes_[inner].node->get_usr(), inner);
+          }
+        } else {
+          // Linkage specs have no USR: unify the ones with equal spelling in one scope
+          auto key = std::make_pair(target, n->get_display_name());
+          auto it = container_by_key_.find(key);
+          if (it != container_by_key_.end()) {
+            inner = it->second;
+          } else {
+            inner = open_scope(n, target);
+            container_by_key_.emplace(std::move(key), inner);
+          }
+        }
+
+        for (const auto& child : children_of(n)) add(child, inner);
+      }
+
+      std::size_t open_scope(const node_ptr& n, std::size_t target) {
+        node_ptr shell = can_move(n) ? n : clone_shallow(n);
+        scopes_[target].children.push_back(shell);
+        scopes_.push_back({std::move(shell), {}});
+        return scopes_.size() - 1;
+      }
+
+      bool move_nodes_;
+      std::vector<scope> scopes_;  // scopes_[0] is the merged root
+      // Views point into nodes the merger holds
+      std::unordered_map<std::string_view, slot> by_usr_;
+      std::unordered_map<std::string_view, std::size_t> container_by_usr_;
+      std::map<std::pair<std::size_t, std::string>, std::size_t> container_by_key_;
+    };
+
+    // Resolve a type to its declaration node. Implicit template instantiations
+    // have no node of their own and resolve to their class template.
+    static node_ptr resolve_type_declaration(const type_info& ti,
+                                             const std::unordered_map<std::string_view, node_ptr>& decls) {
+      const std::string& usr = ti.get_declaration_usr();
+      if (usr.empty()) return nullptr;
+
+      auto it = decls.find(usr);
+      if (it != decls.end()) return it->second;
+
+      for (const auto& ref : ti.get_referenced_usrs()) {
+        auto ref_it = decls.find(ref);
+        if (ref_it != decls.end() && ref_it->second->get_kind() == node::kind::class_template) {
+          return ref_it->second;
+        }
+      }
+      return nullptr;
+    }
+
+    // Link every typed node in a tree to the declaration of its type (definitions preferred)
+    static void link_type_declarations(const node_ptr& root) {
+      if (!root) return;
+
+      std::vector<node_ptr> nodes;
+      std::vector<node_ptr> stack {root};
+      while (!stack.empty()) {
+        node_ptr n = std::move(stack.back());
+        stack.pop_back();
+        const auto& children = n->get_children();
+        stack.insert(stack.end(), children.rbegin(), children.rend());
+        nodes.push_back(std::move(n));
+      }
+
+      // Keys view the nodes' own USR strings, which outlive the map
+      std::unordered_map<std::string_view, node_ptr> decls;
+      decls.reserve(nodes.size());
+      for (const auto& n : nodes) {
+        const std::string& usr = n->get_usr();
+        if (usr.empty()) continue;
+        auto [it, inserted] = decls.emplace(std::string_view(usr), n);
+        if (!inserted && !it->second->is_definition() && n->is_definition()) {
+          it->second = n;
+        }
+      }
+
+      for (const auto& n : nodes) {
+        n->set_type_declaration(resolve_type_declaration(n->get_type(), decls));
+        n->set_return_type_declaration(resolve_type_declaration(n->get_return_type(), decls));
+      }
     }
 
     // Visitor context
     struct visitor_context {
       node_ptr current_parent;
       std::unordered_map<std::string, node_ptr> usr_to_node;
+      usr_registry* registry = nullptr;  // Shared with other parses, may be null
     };
 
+    // Declarations directly in a namespace scope are claimed in the registry;
+    // their members go wherever their owner goes
+    static bool is_claimable(CXCursor cursor, node::kind parent_kind) {
+      switch (parent_kind) {
+        case node::kind::translation_unit:
+        case node::kind::namespace_decl:
+        case node::kind::linkage_spec:
+          break;
+        default:
+          return false;
+      }
+      const CXCursorKind ck = clang_getCursorKind(cursor);
+      return ck != CXCursor_Namespace && ck != CXCursor_LinkageSpec;
+    }
+
     // Visitor callback
     static CXChildVisitResult visit_cursor(CXCursor cursor, CXCursor /* parent */, CXClientData client_data) {
       auto* ctx = static_cast<visitor_context*>(client_data);
@@ -482,6 +767,14 @@ namespace xccmeta {
         return CXChildVisit_Recurse;
       }
 
+      // Skip declarations (and their subtrees) another parse already built
+      if (ctx->registry && is_claimable(cursor, ctx->current_parent->get_kind())) {
+        const std::string usr = cx_string_to_std(clang_getCursorUSR(cursor));
+        if (!usr.empty() && !ctx->registry->claim(usr, clang_isCursorDefinition(cursor) != 0)) {
+          return CXChildVisit_Continue;
+        }
+      }
+
       // Create a new node for this cursor
       node::kind nk = cursor_kind_to_node_kind(clang_getCursorKind(cursor));
       node_ptr new_node = node::create(nk);
@@ -504,13 +797,24 @@ namespace xccmeta {
 
       return CXChildVisit_Continue;
     }
+
+    // parser::parse() with an optional registry
+    static node_ptr parse_translation_unit(std::string_view input, const compile_args& args, usr_registry* registry);
   };
 
   // ============================================================================
   // Parser implementation
   // ============================================================================
 
-  std::shared_ptr<node> parser::parse(const std::string& input, const compile_args& args) {
+  std::shared_ptr<node> parser::parse(std::string_view input, const compile_args& args) {
+    return parser_impl::parse_translation_unit(input, args, nullptr);
+  }
+
+  std::shared_ptr<node> parser::parse(std::string_view input, const compile_args& args, usr_registry& registry) {
+    return parser_impl::parse_translation_unit(input, args, &registry);
+  }
+
+  node_ptr parser_impl::parse_translation_unit(std::string_view input, const compile_args& args, usr_registry* registry) {
     // Create libclang index
     CXIndex index = clang_createIndex(0, 0);
     if (!index) {
@@ -528,7 +832,7 @@ namespace xccmeta {
     // Create an unsaved file for the input
     CXUnsavedFile unsaved_file;
     unsaved_file.Filename = "input.cpp";
-    unsaved_file.Contents = input.c_str();
+    unsaved_file.Contents = input.empty() ? "" : input.data();  // Length-delimited, need not be null-terminated
     unsaved_file.Length = static_cast<unsigned long>(input.size());
 
     // Parse the translation unit
@@ -557,10 +861,13 @@ namespace xccmeta {
     // Set up visitor context
     parser_impl::visitor_context ctx;
     ctx.current_parent = root;
+    ctx.registry = registry;
 
     // Get the cursor for the translation unit and visit
     CXCursor tu_cursor = clang_getTranslationUnitCursor(tu);
     clang_visitChildren(tu_cursor, parser_impl::visit_cursor, &ctx);
+    parser_impl::link_type_declarations(root);
+    root->update_hashes();
 
     // Cleanup
     clang_disposeTranslationUnit(tu);
@@ -573,63 +880,41 @@ namespace xccmeta {
     if (!a) return b;
     if (!b) return a;
 
-    // Create a new merged translation unit
-    node_ptr merged = node::create(node::kind::translation_unit);
-    merged->set_name("merged");
-
-    // Build a map of USR -> node from 'a' for quick lookup
-    std::unordered_map<std::string, node_ptr> usr_map;
-
-    // Helper to collect all nodes with USRs from a tree
-    std::function<void(const node_ptr&, std::unordered_map<std::string, node_ptr>&)> collect_usrs =
-        [&collect_usrs](const node_ptr& n, std::unordered_map<std::string, node_ptr>& map) {
-          if (!n) return;
-          const std::string& usr = n->get_usr();
-          if (!usr.empty()) {
-            map[usr] = n;
-          }
-          for (const auto& child : n->get_children()) {
-            collect_usrs(child, map);
-          }
-        };
-
-    collect_usrs(a, usr_map);
-
-    // Track which USRs from 'b' we've already added
-    std::unordered_set<std::string> added_usrs;
-
-    // Add all children from 'a' (cloned)
-    for (const auto& child : a->get_children()) {
-      node_ptr cloned = parser_impl::clone_node(child);
-      merged->add_child(cloned);
-      const std::string& usr = child->get_usr();
-      if (!usr.empty()) {
-        added_usrs.insert(usr);
-      }
-    }
-
-    // Add children from 'b' that are not already in 'a' (by USR)
-    for (const auto& b_child : b->get_children()) {
-      if (!b_child) continue;
-
-      const std::string& usr = b_child->get_usr();
-
-      if (usr.empty()) {
-        // No USR, just add it
-        merged->add_child(parser_impl::clone_node(b_child));
-        continue;
-      }
+    parser_impl::tree_merger merger(false);
+    merger.add_root(a);
+    merger.add_root(b);
+    return merger.finish();
+  }
 
-      auto it = usr_map.find(usr);
-      if (it == usr_map.end()) {
-        // Not in 'a', add from 'b'
-        merged->add_child(parser_impl::clone_node(b_child));
-        added_usrs.insert(usr);
-      }
-      // If both have the same USR, keep 'a's version (already added)
+  std::shared_ptr<node> parser::merge_all(std::vector<std::shared_ptr<node>> roots, const compile_args& /* args */,
+                                          unsigned thread_count) {
+    if (thread_count == 0) thread_count = std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t workers = std::min<std::size_t>(thread_count, roots.size() / 2);
+
+    if (workers > 1) {
+      // Each worker merges a contiguous range of roots; the partial results are
+      // merged below in range order. Merging is associative (first occurrence
+      // keeps its position, definitions win), so the result is the same as a
+      // serial merge for any thread count.
+      std::vector<node_ptr> partials(workers);
+      std::vector<std::thread> threads;
+      threads.reserve(workers);
+      for (std::size_t w = 0; w < workers; ++w) {
+        const std::size_t first = roots.size() * w / workers;
+        const std::size_t last = roots.size() * (w + 1) / workers;
+        threads.emplace_back([&, w, first, last] {
+          parser_impl::tree_merger merger(true);
+          for (std::size_t i = first; i < last; ++i) merger.add_root(roots[i]);
+          partials[w] = merger.finish(false);
+        });
+      }
+      for (auto& t : threads) t.join();
+      roots = std::move(partials);
     }
 
-    return merged;
+    parser_impl::tree_merger merger(true);
+    for (const auto& root : roots) merger.add_root(root);
+    return merger.finish();
   }
 
 }  // namespace xccmeta
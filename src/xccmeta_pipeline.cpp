@@ -0,0 +1,167 @@
+/*
+MIT License
+
+Copyright (c) 2026 Christian Luppi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <xccmeta/xccmeta_parser.hpp>
+#include <xccmeta/xccmeta_pipeline.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace xccmeta {
+
+  namespace {
+
+    constexpr std::size_t page_size = 4096;
+
+    unsigned resolve_thread_count(unsigned requested) {
+      return requested == 0 ? std::max(1u, std::thread::hardware_concurrency()) : requested;
+    }
+
+    struct loaded_file {
+      std::size_t index = 0;
+      mapped_file content;
+    };
+
+    // Touch every page of a mapping on the reader thread, so the parser never
+    // waits for the disk. Buffered (unmapped) content is already in memory.
+    void prefault(const mapped_file& content) {
+      if (!content.is_mapped()) return;
+      unsigned char sum = 0;
+      for (std::size_t offset = 0; offset < content.size(); offset += page_size) {
+        sum += static_cast<unsigned char>(content.data()[offset]);
+      }
+      volatile unsigned char sink = sum;  // Keeps the loads from being optimized away
+      (void)sink;
+    }
+
+    // FIFO between readers and parse workers. push() blocks while the queue is
+    // full; pop() blocks while it is empty and fails once every reader is done.
+    class read_ahead_queue {
+     public:
+      read_ahead_queue(std::size_t depth, std::size_t byte_limit, std::size_t readers)
+          : depth(std::max<std::size_t>(1, depth)), byte_limit(byte_limit), readers(readers) {}
+
+      void push(loaded_file item) {
+        const std::size_t size = item.content.size();
+        {
+          std::unique_lock lock(mutex);
+          not_full.wait(lock, [&] {
+            return items.empty() ||
+                   (items.size() < depth && (byte_limit == 0 || bytes + size <= byte_limit));
+          });
+          bytes += size;
+          items.push_back(std::move(item));
+        }
+        not_empty.notify_one();
+      }
+
+      bool pop(loaded_file& out) {
+        {
+          std::unique_lock lock(mutex);
+          not_empty.wait(lock, [&] { return !items.empty() || readers == 0; });
+          if (items.empty()) return false;
+          out = std::move(items.front());
+          items.pop_front();
+          bytes -= out.content.size();
+        }
+        // Readers wait on different sizes, so any of them may fit now
+        not_full.notify_all();
+        return true;
+      }
+
+      void reader_done() {
+        {
+          std::lock_guard lock(mutex);
+          readers--;
+        }
+        not_empty.notify_all();
+      }
+
+     private:
+      const std::size_t depth;
+      const std::size_t byte_limit;
+      std::size_t readers;  // Still producing
+      std::size_t bytes = 0;
+      std::deque<loaded_file> items;
+      std::mutex mutex;
+      std::condition_variable not_full;
+      std::condition_variable not_empty;
+    };
+
+  }  // namespace
+
+  parse_pipeline::parse_pipeline(const config& cfg): config_(cfg) {}
+
+  std::vector<node_ptr> parse_pipeline::run(const std::vector<file>& files, const compile_args& args) const {
+    std::vector<node_ptr> roots(files.size());
+    run(files, args, [&roots](std::size_t index, const file&, node_ptr root) { roots[index] = std::move(root); });
+    return roots;
+  }
+
+  void parse_pipeline::run(const std::vector<file>& files, const compile_args& args,
+                           const callback& on_parsed) const {
+    if (files.empty()) return;
+
+    const std::size_t readers = std::min<std::size_t>(resolve_thread_count(config_.read_threads), files.size());
+    const std::size_t parsers = std::min<std::size_t>(resolve_thread_count(config_.parse_threads), files.size());
+    read_ahead_queue queue(config_.queue_depth, config_.queue_bytes, readers);
+
+    // Files are claimed in order, so reads run roughly in input order
+    std::atomic<std::size_t> next {0};
+    auto read_worker = [&] {
+      for (std::size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < files.size();) {
+        loaded_file item {i, files[i].map()};
+        prefault(item.content);
+        queue.push(std::move(item));
+      }
+      queue.reader_done();
+    };
+
+    auto parse_worker = [&] {
+      parser p;
+      loaded_file item;
+      while (queue.pop(item)) {
+        node_ptr root;
+        if (item.content.is_valid()) {
+          root = config_.registry ? p.parse(item.content.view(), args, *config_.registry)
+                                  : p.parse(item.content.view(), args);
+        }
+        item.content = mapped_file();  // Unmap before the callback, which may run long
+        on_parsed(item.index, files[item.index], std::move(root));
+      }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(readers + parsers - 1);
+    for (std::size_t i = 0; i < readers; ++i) threads.emplace_back(read_worker);
+    for (std::size_t i = 1; i < parsers; ++i) threads.emplace_back(parse_worker);
+    parse_worker();  // The calling thread is one of the parse workers
+    for (auto& t : threads) t.join();
+  }
+
+}  // namespace xccmeta
@@ -52,14 +52,14 @@ namespace xccmeta {
   // Move assignment
   preprocessor_context& preprocessor_context::operator=(preprocessor_context&&) noexcept = default;
 
-  preprocessor_context::preprocessor_context(const std::string& input, const compile_args& args) {
+  preprocessor_context::preprocessor_context(std::string_view input, const compile_args& args) {
     data = std::make_unique<internal_data>();
     data->source_code = input;
     data->stored_args = args.get_args();
   }
 
   // Helper function to run the actual preprocessing
-  static std::string run_preprocessor(const std::string& source, const std::vector<std::string>& args) {
+  static std::string run_preprocessor(std::string_view source, const std::vector<std::string>& args) {
     using namespace clang;
 
     // Create diagnostics
@@ -273,7 +273,7 @@ namespace xccmeta {
     target_opts->Triple = llvm::sys::getDefaultTargetTriple();
     TargetInfo* target_info = TargetInfo::CreateTargetInfo(diagnostics, target_opts);
     if (!target_info) {
-      return source;
+      return std::string(source);
     }
 
     // Create file manager and source manager
@@ -409,8 +409,8 @@ namespace xccmeta {
     return result.str();
   }
 
-  std::string preprocessor_context::apply(const std::string& to_preprocess, const compile_args& args) const {
-    if (!data) return to_preprocess;
+  std::string preprocessor_context::apply(std::string_view to_preprocess, const compile_args& args) const {
+    if (!data) return std::string(to_preprocess);
 
     // Combine stored args with provided args
     std::vector<std::string> combined_args = data->stored_args;
@@ -421,28 +421,30 @@ namespace xccmeta {
   }
 
   preprocessor::preprocessor(const file& file, const compile_args& args) {
-    const auto file_contents = file.read();
+    const mapped_file file_contents = file.map();
 
     // Initialize context from the single file's content
-    context = preprocessor_context(file_contents, args);
-    content.push_back(context.apply(file_contents, args));
+    context = preprocessor_context(file_contents.view(), args);
+    content.push_back(context.apply(file_contents.view(), args));
   }
 
   preprocessor::preprocessor(const std::vector<file>& files, const compile_args& args) {
     // Concatenate all file contents to initialize context
-    std::vector<std::string> file_contents;
+    std::vector<mapped_file> file_contents;
+    file_contents.reserve(files.size());
     std::string combined_contents;
     for (const auto& f : files) {
-      file_contents.push_back(f.read());
-      combined_contents += f.read() + "\n";
+      file_contents.push_back(f.map());
+      combined_contents += file_contents.back().view();
+      combined_contents += '\n';
     }
 
     // Initialize context from combined contents
     context = preprocessor_context(combined_contents, args);
 
     // Preprocess each file's content
-    for (const auto& content_str : file_contents) {
-      content.push_back(context.apply(content_str, args));
+    for (const auto& mapped : file_contents) {
+      content.push_back(context.apply(mapped.view(), args));
     }
   }
 
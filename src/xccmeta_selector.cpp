@@ -0,0 +1,642 @@
+/*
+MIT License
+
+Copyright (c) 2026 Christian Luppi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "xccmeta/xccmeta_selector.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <string_view>
+
+namespace xccmeta {
+
+  // ============================================================================
+  // Compiled program
+  // ============================================================================
+
+  struct selector::program {
+    enum class field {
+      name,
+      qualified_name,
+      display_name,
+      usr,
+      type
+    };
+
+    enum class comparison {
+      equal,
+      not_equal,
+      prefix,
+      suffix,
+      contains
+    };
+
+    enum class flag {
+      definition,
+      virtual_,
+      pure_virtual,
+      override_,
+      final_,
+      static_,
+      const_,
+      inline_,
+      explicit_,
+      constexpr_,
+      noexcept_,
+      deleted,
+      defaulted,
+      anonymous,
+      scoped,
+      template_,
+      specialization,
+      variadic,
+      bitfield,
+      virtual_base,
+      public_,
+      protected_,
+      private_
+    };
+
+    struct predicate {
+      enum class type {
+        tag,
+        attribute,
+        flag,
+        negation
+      };
+
+      type kind = type::tag;
+      tag_id tag = tag::invalid_id;
+      field attribute = field::name;
+      comparison op = comparison::equal;
+      std::string value;
+      program::flag property = flag::definition;
+      std::size_t negated = 0;  // Index into compounds
+    };
+
+    struct compound {
+      bool any_kind = true;
+      node::kind kind = node::kind::unknown;
+      std::vector<predicate> predicates;
+    };
+
+    struct step {
+      std::size_t compound = 0;
+      bool direct_child = false;  // Combinator linking this step to the previous one
+    };
+
+    using chain = std::vector<step>;
+
+    std::vector<compound> compounds;
+    std::vector<chain> chains;
+
+    static const std::string& get_field(const node* n, field f) {
+      switch (f) {
+        case field::name:           return n->get_name();
+        case field::qualified_name: return n->get_qualified_name();
+        case field::display_name:   return n->get_display_name();
+        case field::usr:            return n->get_usr();
+        case field::type:           return n->get_type().get_spelling();
+        default:                    return n->get_name();
+      }
+    }
+
+    static bool compare(std::string_view actual, comparison op, std::string_view expected) {
+      switch (op) {
+        case comparison::equal:     return actual == expected;
+        case comparison::not_equal: return actual != expected;
+        case comparison::prefix:    return actual.substr(0, expected.size()) == expected;
+        case comparison::suffix:    return actual.size() >= expected.size() && actual.substr(actual.size() - expected.size()) == expected;
+        case comparison::contains:  return actual.find(expected) != std::string_view::npos;
+        default:                    return false;
+      }
+    }
+
+    static bool test_flag(const node* n, flag f) {
+      switch (f) {
+        case flag::definition:     return n->is_definition();
+        case flag::virtual_:       return n->is_virtual();
+        case flag::pure_virtual:   return n->is_pure_virtual();
+        case flag::override_:      return n->is_override();
+        case flag::final_:         return n->is_final();
+        case flag::static_:        return n->is_static();
+        case flag::const_:         return n->is_const_method();
+        case flag::inline_:        return n->is_inline();
+        case flag::explicit_:      return n->is_explicit();
+        case flag::constexpr_:     return n->is_constexpr();
+        case flag::noexcept_:      return n->is_noexcept();
+        case flag::deleted:        return n->is_deleted();
+        case flag::defaulted:      return n->is_defaulted();
+        case flag::anonymous:      return n->is_anonymous();
+        case flag::scoped:         return n->is_scoped_enum();
+        case flag::template_:      return n->is_template();
+        case flag::specialization: return n->is_template_specialization();
+        case flag::variadic:       return n->is_variadic();
+        case flag::bitfield:       return n->is_bitfield();
+        case flag::virtual_base:   return n->is_virtual_base();
+        case flag::public_:        return n->get_access() == access_specifier::public_;
+        case flag::protected_:     return n->get_access() == access_specifier::protected_;
+        case flag::private_:       return n->get_access() == access_specifier::private_;
+        default:                   return false;
+      }
+    }
+
+    bool test(std::size_t compound_index, const node* n) const {
+      const compound& c = compounds[compound_index];
+      if (!c.any_kind && n->get_kind() != c.kind) return false;
+
+      for (const auto& p : c.predicates) {
+        switch (p.kind) {
+          case predicate::type::tag:
+            if (!n->has_tag(p.tag)) return false;
+            break;
+          case predicate::type::attribute:
+            if (!compare(get_field(n, p.attribute), p.op, p.value)) return false;
+            break;
+          case predicate::type::flag:
+            if (!test_flag(n, p.property)) return false;
+            break;
+          case predicate::type::negation:
+            if (test(p.negated, n)) return false;
+            break;
+        }
+      }
+      return true;
+    }
+
+    // Match steps [0, index) against the ancestors in path[0, limit)
+    bool match_ancestors(const chain& ch, std::size_t index, const std::vector<const node*>& path, std::size_t limit) const {
+      if (index == 0) return true;
+
+      const std::size_t compound_index = ch[index - 1].compound;
+      if (ch[index].direct_child) {
+        if (limit == 0) return false;
+        const node* parent = path[limit - 1];
+        return test(compound_index, parent) && match_ancestors(ch, index - 1, path, limit - 1);
+      }
+
+      for (std::size_t i = limit; i > 0; --i) {
+        if (test(compound_index, path[i - 1]) && match_ancestors(ch, index - 1, path, i - 1)) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    bool match_chain(const chain& ch, const std::vector<const node*>& path, const node* candidate) const {
+      if (!test(ch.back().compound, candidate)) return false;
+      return match_ancestors(ch, ch.size() - 1, path, path.size());
+    }
+
+    bool matches(const std::vector<const node*>& path, const node* candidate) const {
+      for (const auto& ch : chains) {
+        if (match_chain(ch, path, candidate)) return true;
+      }
+      return false;
+    }
+  };
+
+  // ============================================================================
+  // Selector compiler
+  // ============================================================================
+
+  namespace {
+
+    class selector_compiler {
+     public:
+      selector_compiler(const std::string& source, selector::program& prog): src(source), prog(prog) {
+      }
+
+      bool compile() {
+        skip_whitespace();
+        if (at_end()) return fail("empty selector");
+
+        while (true) {
+          if (!parse_chain()) return false;
+          skip_whitespace();
+          if (at_end()) return true;
+          if (peek() != ',') return fail("unexpected character '" + std::string(1, peek()) + "'");
+          ++pos;
+        }
+      }
+
+      const std::string& get_error() const { return error; }
+
+     private:
+      using program = selector::program;
+
+      bool at_end() const { return pos >= src.size(); }
+      char peek() const { return at_end() ? '\0' : src[pos]; }
+
+      bool skip_whitespace() {
+        std::size_t start = pos;
+        while (!at_end() && std::isspace(static_cast<unsigned char>(src[pos]))) ++pos;
+        return pos != start;
+      }
+
+      bool fail(const std::string& message) {
+        error = message + " at offset " + std::to_string(pos);
+        return false;
+      }
+
+      static bool is_ident_char(char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+      }
+
+      std::string read_identifier() {
+        std::size_t start = pos;
+        while (!at_end() && is_ident_char(src[pos])) ++pos;
+        return src.substr(start, pos - start);
+      }
+
+      static bool lookup_kind(const std::string& name, node::kind& out) {
+        const int last = static_cast<int>(node::kind::static_assert_decl);
+        for (int i = 0; i <= last; ++i) {
+          auto k = static_cast<node::kind>(i);
+          std::string_view kind_name = node::kind_to_string(k);
+          if (kind_name == name || (kind_name.size() == name.size() + 5 &&
+                                    kind_name.substr(0, name.size()) == name &&
+                                    kind_name.substr(name.size()) == "_decl")) {
+            out = k;
+            return true;
+          }
+        }
+        return false;
+      }
+
+      static bool lookup_flag(const std::string& name, program::flag& out) {
+        static const std::pair<const char*, program::flag> flags[] = {
+            {"definition", program::flag::definition},
+            {"virtual", program::flag::virtual_},
+            {"pure_virtual", program::flag::pure_virtual},
+            {"override", program::flag::override_},
+            {"final", program::flag::final_},
+            {"static", program::flag::static_},
+            {"const", program::flag::const_},
+            {"inline", program::flag::inline_},
+            {"explicit", program::flag::explicit_},
+            {"constexpr", program::flag::constexpr_},
+            {"noexcept", program::flag::noexcept_},
+            {"deleted", program::flag::deleted},
+            {"defaulted", program::flag::defaulted},
+            {"anonymous", program::flag::anonymous},
+            {"scoped", program::flag::scoped},
+            {"template", program::flag::template_},
+            {"specialization", program::flag::specialization},
+            {"variadic", program::flag::variadic},
+            {"bitfield", program::flag::bitfield},
+            {"virtual_base", program::flag::virtual_base},
+            {"public", program::flag::public_},
+            {"protected", program::flag::protected_},
+            {"private", program::flag::private_},
+        };
+        for (const auto& [flag_name, f] : flags) {
+          if (name == flag_name) {
+            out = f;
+            return true;
+          }
+        }
+        return false;
+      }
+
+      static bool lookup_field(const std::string& name, program::field& out) {
+        if (name == "name") out = program::field::name;
+        else if (name == "qualified_name") out = program::field::qualified_name;
+        else if (name == "display_name") out = program::field::display_name;
+        else if (name == "usr") out = program::field::usr;
+        else if (name == "type") out = program::field::type;
+        else return false;
+        return true;
+      }
+
+      bool parse_chain() {
+        program::chain ch;
+        bool direct_child = false;
+        skip_whitespace();
+
+        while (true) {
+          std::size_t compound_index = 0;
+          if (!parse_compound(compound_index)) return false;
+          ch.push_back({compound_index, direct_child});
+
+          bool had_space = skip_whitespace();
+          if (peek() == '>') {
+            ++pos;
+            skip_whitespace();
+            direct_child = true;
+            continue;
+          }
+          if (had_space && !at_end() && peek() != ',') {
+            direct_child = false;
+            continue;
+          }
+          break;
+        }
+
+        prog.chains.push_back(std::move(ch));
+        return true;
+      }
+
+      bool parse_compound(std::size_t& out_index) {
+        program::compound c;
+        std::size_t start = pos;
+
+        if (peek() == '*') {
+          ++pos;
+        } else if (is_ident_char(peek())) {
+          std::string name = read_identifier();
+          if (!lookup_kind(name, c.kind)) return fail("unknown node kind '" + name + "'");
+          c.any_kind = false;
+        }
+
+        while (!at_end()) {
+          if (peek() == '[') {
+            program::predicate p;
+            if (!parse_attribute(p)) return false;
+            c.predicates.push_back(std::move(p));
+          } else if (peek() == ':') {
+            program::predicate p;
+            if (!parse_pseudo(p)) return false;
+            c.predicates.push_back(std::move(p));
+          } else {
+            break;
+          }
+        }
+
+        if (pos == start) return fail("expected a node kind, '*', '[' or ':'");
+
+        out_index = prog.compounds.size();
+        prog.compounds.push_back(std::move(c));
+        return true;
+      }
+
+      bool parse_value(std::string& out) {
+        if (peek() == '"' || peek() == '\'') {
+          char quote = src[pos++];
+          std::size_t start = pos;
+          while (!at_end() && src[pos] != quote) ++pos;
+          if (at_end()) return fail("unterminated string");
+          out = src.substr(start, pos - start);
+          ++pos;
+          skip_whitespace();
+          return true;
+        }
+
+        std::size_t start = pos;
+        while (!at_end() && src[pos] != ']') ++pos;
+        std::size_t end = pos;
+        while (end > start && std::isspace(static_cast<unsigned char>(src[end - 1]))) --end;
+        out = src.substr(start, end - start);
+        return true;
+      }
+
+      bool parse_attribute(program::predicate& p) {
+        ++pos;  // '['
+        skip_whitespace();
+
+        if (peek() == '@') {
+          ++pos;
+          std::size_t start = pos;
+          while (!at_end() && src[pos] != ']' && !std::isspace(static_cast<unsigned char>(src[pos]))) ++pos;
+          if (pos == start) return fail("expected a tag name");
+          p.kind = program::predicate::type::tag;
+          p.tag = tag::intern(src.substr(start, pos - start));
+        } else {
+          std::string name = read_identifier();
+          if (!lookup_field(name, p.attribute)) return fail("unknown attribute '" + name + "'");
+          skip_whitespace();
+
+          static const std::pair<const char*, program::comparison> ops[] = {
+              {"!=", program::comparison::not_equal},
+              {"^=", program::comparison::prefix},
+              {"$=", program::comparison::suffix},
+              {"*=", program::comparison::contains},
+              {"=", program::comparison::equal},
+          };
+          bool found = false;
+          for (const auto& [text, op] : ops) {
+            std::string_view token(text);
+            if (src.compare(pos, token.size(), token) == 0) {
+              pos += token.size();
+              p.op = op;
+              found = true;
+              break;
+            }
+          }
+          if (!found) return fail("expected a comparison operator");
+
+          skip_whitespace();
+          p.kind = program::predicate::type::attribute;
+          if (!parse_value(p.value)) return false;
+        }
+
+        skip_whitespace();
+        if (peek() != ']') return fail("expected ']'");
+        ++pos;
+        return true;
+      }
+
+      bool parse_pseudo(program::predicate& p) {
+        ++pos;  // ':'
+        std::string name = read_identifier();
+
+        if (name == "not") {
+          if (peek() != '(') return fail("expected '(' after :not");
+          ++pos;
+          skip_whitespace();
+          std::size_t negated = 0;
+          if (!parse_compound(negated)) return false;
+          skip_whitespace();
+          if (peek() != ')') return fail("expected ')'");
+          ++pos;
+          p.kind = program::predicate::type::negation;
+          p.negated = negated;
+          return true;
+        }
+
+        if (!lookup_flag(name, p.property)) return fail("unknown pseudo-class ':" + name + "'");
+        p.kind = program::predicate::type::flag;
+        return true;
+      }
+
+      const std::string& src;
+      selector::program& prog;
+      std::size_t pos = 0;
+      std::string error;
+    };
+
+  }  // namespace
+
+  // ============================================================================
+  // selector
+  // ============================================================================
+
+  selector::selector(const std::string& source): source_(source) {
+    auto prog = std::make_shared<program>();
+    selector_compiler compiler(source_, *prog);
+    if (compiler.compile()) {
+      program_ = std::move(prog);
+    } else {
+      error_ = compiler.get_error();
+    }
+  }
+
+  bool selector::is_valid() const {
+    return program_ != nullptr;
+  }
+
+  const std::string& selector::get_error() const {
+    return error_;
+  }
+
+  const std::string& selector::get_source() const {
+    return source_;
+  }
+
+  bool selector::matches(const node_ptr& n) const {
+    if (!program_ || !n) return false;
+
+    // Keep the ancestors alive while matching against raw pointers
+    std::vector<node_ptr> owners;
+    for (node_ptr p = n->get_parent(); p; p = p->get_parent()) {
+      owners.push_back(p);
+    }
+
+    std::vector<const node*> path;
+    path.reserve(owners.size());
+    for (auto it = owners.rbegin(); it != owners.rend(); ++it) {
+      path.push_back(it->get());
+    }
+    return program_->matches(path, n.get());
+  }
+
+  selector::selection selector::select(const node_ptr& root) const {
+    return selection(program_, root);
+  }
+
+  std::vector<std::vector<node_ptr>> selector::select_many(const node_ptr& root, const std::vector<selector>& selectors) {
+    std::vector<std::vector<node_ptr>> results(selectors.size());
+    if (!root) return results;
+
+    // Bucket chains by the kind of their rightmost compound so each node only
+    // tests the selectors that can possibly match it.
+    struct entry {
+      std::size_t selector_index;
+      const program* prog;
+      const program::chain* chain;
+    };
+    const std::size_t kind_count = static_cast<std::size_t>(node::kind::static_assert_decl) + 1;
+    std::vector<std::vector<entry>> by_kind(kind_count);
+    std::vector<entry> any_kind;
+
+    for (std::size_t i = 0; i < selectors.size(); ++i) {
+      const program* prog = selectors[i].program_.get();
+      if (!prog) continue;
+      for (const auto& ch : prog->chains) {
+        const auto& rightmost = prog->compounds[ch.back().compound];
+        entry e {i, prog, &ch};
+        if (rightmost.any_kind) {
+          any_kind.push_back(e);
+        } else {
+          by_kind[static_cast<std::size_t>(rightmost.kind)].push_back(e);
+        }
+      }
+    }
+
+    std::vector<const node*> path;
+    std::vector<const node*> last_match(selectors.size(), nullptr);  // A selector list matches a node once
+
+    auto test = [&](const std::vector<entry>& entries, const node_ptr& candidate) {
+      for (const auto& e : entries) {
+        if (last_match[e.selector_index] == candidate.get()) continue;
+        if (e.prog->match_chain(*e.chain, path, candidate.get())) {
+          last_match[e.selector_index] = candidate.get();
+          results[e.selector_index].push_back(candidate);
+        }
+      }
+    };
+
+    auto visit = [&](auto& self, const node* parent) -> void {
+      path.push_back(parent);
+      for (const auto& child : parent->get_children()) {
+        const auto k = static_cast<std::size_t>(child->get_kind());
+        if (k < kind_count) test(by_kind[k], child);
+        test(any_kind, child);
+        self(self, child.get());
+      }
+      path.pop_back();
+    };
+    visit(visit, root.get());
+
+    return results;
+  }
+
+  // ============================================================================
+  // selection
+  // ============================================================================
+
+  selector::selection::selection(std::shared_ptr<const program> prog, node_ptr root)
+      : program_(std::move(prog)), root_(std::move(root)) {
+  }
+
+  std::vector<node_ptr> selector::selection::to_vector() const {
+    std::vector<node_ptr> result;
+    for (const auto& n : *this) {
+      result.push_back(n);
+    }
+    return result;
+  }
+
+  selector::selection::iterator::iterator(std::shared_ptr<const program> prog, const node_ptr& root)
+      : program_(std::move(prog)), root_(root) {
+    if (!program_ || !root_) return;
+    path_.push_back(root_.get());
+    stack_.push_back({root_.get(), 0});
+    advance();
+  }
+
+  void selector::selection::iterator::advance() {
+    while (!stack_.empty()) {
+      frame& top = stack_.back();
+      const auto& children = top.parent->get_children();
+      if (top.next_child >= children.size()) {
+        stack_.pop_back();
+        path_.pop_back();
+        continue;
+      }
+
+      const node_ptr& child = children[top.next_child++];
+      const bool hit = program_->matches(path_, child.get());
+
+      path_.push_back(child.get());
+      stack_.push_back({child.get(), 0});
+
+      if (hit) {
+        current_ = child;
+        return;
+      }
+    }
+    current_.reset();
+  }
+
+}  // namespace xccmeta
@@ -0,0 +1,163 @@
+/*
+MIT License
+
+Copyright (c) 2026 Christian Luppi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "xccmeta/xccmeta_snapshot.hpp"
+
+namespace xccmeta {
+
+  snapshot snapshot::freeze(const node_ptr& root) {
+    snapshot result;
+    if (!root) return result;
+
+    auto d = std::make_shared<data>();
+    d->root = root;
+
+    // Iterative preorder walk; children handles are assigned when each node is
+    // visited, so they are filled in a second pass below.
+    struct frame {
+      const node* n;
+      handle parent;
+      std::uint32_t depth;
+    };
+    std::vector<frame> stack;
+    stack.push_back({root.get(), invalid_handle, 0});
+
+    while (!stack.empty()) {
+      frame f = stack.back();
+      stack.pop_back();
+
+      const handle h = static_cast<handle>(d->nodes.size());
+      d->nodes.push_back(f.n);
+      d->parents.push_back(f.parent);
+      d->depths.push_back(f.depth);
+      d->by_node.emplace(f.n, h);
+
+      // Warm memoized data so concurrent readers never write
+      f.n->get_all_tags_view();
+
+      const std::string& usr = f.n->get_usr();
+      if (!usr.empty()) {
+        auto [it, inserted] = d->by_usr.emplace(std::string_view(usr), h);
+        if (!inserted && !d->nodes[it->second]->is_definition() && f.n->is_definition()) {
+          it->second = h;
+        }
+      }
+
+      const auto& children = f.n->get_children();
+      for (auto it = children.rbegin(); it != children.rend(); ++it) {
+        stack.push_back({it->get(), h, f.depth + 1});
+      }
+    }
+
+    const std::size_t count = d->nodes.size();
+
+    // Subtree sizes, accumulated bottom-up (children always follow their parent)
+    d->subtree_sizes.assign(count, 1);
+    for (std::size_t i = count; i-- > 1;) {
+      d->subtree_sizes[d->parents[i]] += d->subtree_sizes[i];
+    }
+
+    // Child lists in CSR form
+    d->child_offsets.assign(count + 1, 0);
+    for (std::size_t i = 1; i < count; ++i) {
+      d->child_offsets[d->parents[i] + 1]++;
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+      d->child_offsets[i + 1] += d->child_offsets[i];
+    }
+    d->child_handles.resize(count > 0 ? count - 1 : 0);
+    std::vector<std::uint32_t> fill(d->child_offsets.begin(), d->child_offsets.end() - 1);
+    for (std::size_t i = 1; i < count; ++i) {
+      d->child_handles[fill[d->parents[i]]++] = static_cast<handle>(i);
+    }
+
+    result.data_ = std::move(d);
+    return result;
+  }
+
+  bool snapshot::empty() const {
+    return !data_ || data_->nodes.empty();
+  }
+
+  std::size_t snapshot::size() const {
+    return data_ ? data_->nodes.size() : 0;
+  }
+
+  snapshot::handle snapshot::get_root() const {
+    return empty() ? invalid_handle : 0;
+  }
+
+  const node_ptr& snapshot::get_root_node() const {
+    static const node_ptr null_node;
+    return data_ ? data_->root : null_node;
+  }
+
+  const node& snapshot::get(handle h) const {
+    return *data_->nodes[h];
+  }
+
+  std::span<const node* const> snapshot::get_nodes() const {
+    if (!data_) return {};
+    return data_->nodes;
+  }
+
+  snapshot::handle snapshot::get_parent(handle h) const {
+    return data_->parents[h];
+  }
+
+  std::span<const snapshot::handle> snapshot::get_children(handle h) const {
+    const auto begin = data_->child_offsets[h];
+    const auto end = data_->child_offsets[h + 1];
+    return std::span<const handle>(data_->child_handles.data() + begin, end - begin);
+  }
+
+  std::size_t snapshot::get_depth(handle h) const {
+    return data_->depths[h];
+  }
+
+  std::size_t snapshot::get_subtree_size(handle h) const {
+    return data_->subtree_sizes[h];
+  }
+
+  bool snapshot::is_ancestor(handle ancestor, handle descendant) const {
+    return ancestor < descendant && descendant < ancestor + data_->subtree_sizes[ancestor];
+  }
+
+  snapshot::handle snapshot::find(const node* n) const {
+    if (!data_) return invalid_handle;
+    auto it = data_->by_node.find(n);
+    return it != data_->by_node.end() ? it->second : invalid_handle;
+  }
+
+  snapshot::handle snapshot::find_by_usr(std::string_view usr) const {
+    if (!data_ || usr.empty()) return invalid_handle;
+    auto it = data_->by_usr.find(usr);
+    return it != data_->by_usr.end() ? it->second : invalid_handle;
+  }
+
+  snapshot freeze(const node_ptr& root) {
+    return snapshot::freeze(root);
+  }
+
+}  // namespace xccmeta
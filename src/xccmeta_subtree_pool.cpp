@@ -0,0 +1,233 @@
+/*
+MIT License
+
+Copyright (c) 2026 Christian Luppi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <xccmeta/xccmeta_subtree_pool.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace xccmeta {
+
+  namespace {
+
+    // Cheap guard against hash collisions; the hash already covers the whole subtree
+    bool same_subtree(const node& a, const node& b) {
+      return a.get_hash_with_locations() == b.get_hash_with_locations() && a.get_kind() == b.get_kind() &&
+             a.get_usr() == b.get_usr() && a.get_name() == b.get_name() &&
+             a.get_children().size() == b.get_children().size();
+    }
+
+    // Declarations are pooled below these; the scopes themselves stay per root
+    bool is_scope(const node& n) {
+      return n.get_kind() == node::kind::translation_unit || n.get_kind() == node::kind::namespace_decl ||
+             n.get_kind() == node::kind::linkage_spec;
+    }
+
+    // Shared nodes keep the inherited tags of their first holder, so the new one must agree
+    bool same_context(const node& a, const node& b) {
+      auto a_tags = a.get_parent_tags_view();
+      auto b_tags = b.get_parent_tags_view();
+      return std::equal(a_tags.begin(), a_tags.end(), b_tags.begin(), b_tags.end(), [](const tag& x, const tag& y) {
+        return x.get_name() == y.get_name() && x.get_args() == y.get_args();
+      });
+    }
+
+    // Map every node of a replaced subtree to its counterpart in the pooled one
+    void map_subtree(const node_ptr& replaced, const node_ptr& pooled,
+                     std::unordered_map<const node*, node_ptr>& remap) {
+      std::vector<std::pair<const node_ptr*, const node_ptr*>> stack {{&replaced, &pooled}};
+      while (!stack.empty()) {
+        auto [from, to] = stack.back();
+        stack.pop_back();
+        remap.emplace(from->get(), *to);
+
+        const auto& from_children = (*from)->get_children();
+        const auto& to_children = (*to)->get_children();
+        const std::size_t count = std::min(from_children.size(), to_children.size());
+        for (std::size_t i = 0; i < count; ++i) {
+          stack.push_back({&from_children[i], &to_children[i]});
+        }
+      }
+    }
+
+    void collect_subtree(const node_ptr& n, std::vector<node_ptr>& out) {
+      std::vector<node_ptr> stack {n};
+      while (!stack.empty()) {
+        node_ptr current = std::move(stack.back());
+        stack.pop_back();
+        for (const auto& child : current->get_children()) {
+          stack.push_back(child);
+        }
+        out.push_back(std::move(current));
+      }
+    }
+
+  }  // namespace
+
+  // =============================================================================
+  // subtree_pool
+  // =============================================================================
+
+  std::size_t subtree_pool::intern(const node_ptr& root) {
+    if (!root) return 0;
+    if (entries_ >= sweep_at_) sweep();
+
+    std::unordered_map<const node*, node_ptr> remap;
+    std::vector<node_ptr> released;  // Kept alive until links into them are redirected
+    std::vector<node_ptr> own;  // Nodes of root outside subtrees that were already pooled
+    std::vector<node_ptr> stack {root};
+
+    while (!stack.empty()) {
+      node_ptr n = std::move(stack.back());
+      stack.pop_back();
+
+      const auto& children = n->get_children();
+      for (std::size_t i = 0; i < children.size(); ++i) {
+        const node_ptr& child = children[i];
+        if (is_scope(*child)) {
+          stack.push_back(child);
+          continue;
+        }
+
+        auto& instances = by_hash_[child->get_hash_with_locations()];
+        node_ptr match;
+        bool held = false;
+        for (const auto& weak : instances) {
+          node_ptr pooled = weak.lock();
+          if (!pooled) continue;
+          if (pooled == child) {
+            held = true;
+            break;
+          }
+          // An unshared instance whose tree is gone has lost its inherited tags
+          if (!pooled->is_shared() && !pooled->get_parent()) continue;
+          if (same_subtree(*pooled, *child) && same_context(*pooled, *child)) {
+            match = std::move(pooled);
+            break;
+          }
+        }
+
+        if (held) continue;  // Already shared
+        if (match) {
+          map_subtree(child, match, remap);
+          released.push_back(child);
+          n->share_child(i, std::move(match));
+        } else {
+          instances.push_back(child);
+          ++entries_;
+          collect_subtree(child, own);
+        }
+      }
+      own.push_back(std::move(n));
+    }
+
+    // Links into released subtrees would expire with them
+    if (!remap.empty()) {
+      for (const auto& n : own) {
+        if (auto it = remap.find(n->get_type_declaration().get()); it != remap.end()) {
+          n->set_type_declaration(it->second);
+        }
+        if (auto it = remap.find(n->get_return_type_declaration().get()); it != remap.end()) {
+          n->set_return_type_declaration(it->second);
+        }
+      }
+    }
+    return remap.size();
+  }
+
+  bool subtree_pool::contains(const node_ptr& n) const {
+    if (!n) return false;
+    auto it = by_hash_.find(n->get_hash_with_locations());
+    if (it == by_hash_.end()) return false;
+    return std::any_of(it->second.begin(), it->second.end(), [&](const node_weak_ptr& weak) {
+      return weak.lock() == n;
+    });
+  }
+
+  std::size_t subtree_pool::size() const {
+    std::size_t live = 0;
+    for (const auto& [hash, instances] : by_hash_) {
+      live += std::count_if(instances.begin(), instances.end(), [](const node_weak_ptr& weak) {
+        return !weak.expired();
+      });
+    }
+    return live;
+  }
+
+  void subtree_pool::clear() {
+    by_hash_.clear();
+    entries_ = 0;
+    sweep_at_ = 64;
+  }
+
+  void subtree_pool::sweep() {
+    entries_ = 0;
+    for (auto it = by_hash_.begin(); it != by_hash_.end();) {
+      auto& instances = it->second;
+      std::erase_if(instances, [](const node_weak_ptr& weak) { return weak.expired(); });
+      entries_ += instances.size();
+      it = instances.empty() ? by_hash_.erase(it) : std::next(it);
+    }
+    sweep_at_ = std::max<std::size_t>(64, entries_ * 2);  // Amortized over as many interned subtrees
+  }
+
+  // =============================================================================
+  // node_path
+  // =============================================================================
+
+  node_path::node_path(node_ptr root) {
+    path_.push_back(std::move(root));
+  }
+
+  const node_ptr& node_path::get_root() const {
+    return path_.front();
+  }
+
+  const node_ptr& node_path::get_node() const {
+    return path_.back();
+  }
+
+  node_ptr node_path::get_parent() const {
+    return path_.size() > 1 ? path_[path_.size() - 2] : nullptr;
+  }
+
+  std::size_t node_path::get_depth() const {
+    return path_.size() - 1;
+  }
+
+  bool node_path::to_child(std::size_t index) {
+    const node_ptr& current = path_.back();
+    if (!current || index >= current->get_children().size()) return false;
+    path_.push_back(current->get_children()[index]);
+    return true;
+  }
+
+  bool node_path::to_parent() {
+    if (path_.size() <= 1) return false;
+    path_.pop_back();
+    return true;
+  }
+
+}  // namespace xccmeta
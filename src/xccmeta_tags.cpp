@@ -24,8 +24,60 @@ SOFTWARE.
 
 #include "xccmeta/xccmeta_tags.hpp"
 
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
 namespace xccmeta {
 
+  // Process-wide tag name table. Names live in a deque so references handed
+  // out by name_of() stay valid while new names are interned.
+  class tag_registry {
+   public:
+    static tag_registry& get() {
+      static tag_registry instance;
+      return instance;
+    }
+
+    tag_id intern(const std::string& name) {
+      {
+        std::shared_lock lock(mutex);
+        auto it = ids.find(name);
+        if (it != ids.end()) return it->second;
+      }
+      std::unique_lock lock(mutex);
+      auto it = ids.find(name);
+      if (it != ids.end()) return it->second;
+      tag_id id = static_cast<tag_id>(names.size());
+      names.push_back(name);
+      ids.emplace(name, id);
+      return id;
+    }
+
+    tag_id lookup(const std::string& name) const {
+      std::shared_lock lock(mutex);
+      auto it = ids.find(name);
+      return it != ids.end() ? it->second : tag::invalid_id;
+    }
+
+    const std::string& name_of(tag_id id) const {
+      static const std::string empty;
+      std::shared_lock lock(mutex);
+      return id < names.size() ? names[id] : empty;
+    }
+
+   private:
+    tag_registry() {
+      names.emplace_back();
+      ids.emplace(std::string(), 0);
+    }
+
+    mutable std::shared_mutex mutex;
+    std::unordered_map<std::string, tag_id> ids;
+    std::deque<std::string> names;
+  };
+
   // Helper function to trim whitespace from both ends of a string
   static std::string trim(const std::string& str) {
     size_t first = str.find_first_not_of(" \t\n\r\f\v");
@@ -34,7 +86,19 @@ namespace xccmeta {
     return str.substr(first, last - first + 1);
   }
 
-  tag::tag(const std::string& name, const std::vector<std::string>& args): name(name), args(args) {
+  tag::tag(const std::string& name, const std::vector<std::string>& args): name(name), args(args), id(intern(name)) {
+  }
+
+  tag_id tag::intern(const std::string& name) {
+    return tag_registry::get().intern(name);
+  }
+
+  tag_id tag::lookup(const std::string& name) {
+    return tag_registry::get().lookup(name);
+  }
+
+  const std::string& tag::name_of(tag_id id) {
+    return tag_registry::get().name_of(id);
   }
 
   tag tag::parse(const std::string& to_parse) {
@@ -42,10 +106,12 @@ namespace xccmeta {
     auto paren_pos = to_parse.find('(');
     if (paren_pos == std::string::npos) {
       result.name = trim(to_parse);
+      result.id = intern(result.name);
       return result;
     }
 
     result.name = trim(to_parse.substr(0, paren_pos));
+    result.id = intern(result.name);
     auto args_str = to_parse.substr(paren_pos + 1, to_parse.length() - paren_pos - 2);
 
     size_t start = 0;
@@ -101,6 +167,10 @@ namespace xccmeta {
     return args;
   }
 
+  tag_id tag::get_id() const {
+    return id;
+  }
+
   std::string tag::get_args_combined() const {
     std::string combined;
     for (size_t i = 0; i < args.size(); ++i) {
@@ -0,0 +1,316 @@
+/*
+MIT License
+
+Copyright (c) 2026 Christian Luppi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "xccmeta/xccmeta_type_graph.hpp"
+
+#include <algorithm>
+
+namespace xccmeta {
+
+  namespace {
+
+    bool is_graph_type(const node& n) {
+      return n.is_type_decl() || n.get_kind() == node::kind::class_template;
+    }
+
+    // All type declarations of a tree, in preorder
+    std::vector<node_ptr> collect_types(const node_ptr& root) {
+      std::vector<node_ptr> result;
+      if (!root) return result;
+
+      std::vector<node_ptr> stack {root};
+      while (!stack.empty()) {
+        node_ptr n = std::move(stack.back());
+        stack.pop_back();
+        const auto& children = n->get_children();
+        stack.insert(stack.end(), children.rbegin(), children.rend());
+        if (is_graph_type(*n) && !n->get_usr().empty()) {
+          result.push_back(std::move(n));
+        }
+      }
+      return result;
+    }
+
+    // USRs a type declaration depends on
+    void collect_dependency_usrs(const node& decl, std::vector<std::string>& out) {
+      auto append = [&out](const type_info& ti) {
+        const auto& refs = ti.get_referenced_usrs();
+        out.insert(out.end(), refs.begin(), refs.end());
+      };
+
+      if (decl.get_kind() == node::kind::typedef_decl || decl.get_kind() == node::kind::type_alias_decl) {
+        append(decl.get_type());
+        return;
+      }
+      for (const auto& field : decl.get_fields()) append(field->get_type());
+      for (const auto& base : decl.get_bases()) append(base->get_type());
+    }
+
+  }  // namespace
+
+  type_graph::type_graph(const node_ptr& root) {
+    add(root);
+  }
+
+  // ============================================================================
+  // Maintenance
+  // ============================================================================
+
+  type_graph::vertex type_graph::intern(const std::string& usr) {
+    auto [it, inserted] = by_usr_.emplace(usr, static_cast<vertex>(vertices_.size()));
+    if (inserted) {
+      vertices_.emplace_back();
+      vertices_.back().usr = usr;
+    }
+    return it->second;
+  }
+
+  void type_graph::refresh(vertex v) {
+    auto& data = vertices_[v];
+
+    // First definition wins, otherwise the first declaration
+    node_ptr chosen;
+    for (const auto& d : data.declarations) {
+      if (d.decl->is_definition()) {
+        chosen = d.decl;
+        break;
+      }
+    }
+    if (!chosen && !data.declarations.empty()) chosen = data.declarations.front().decl;
+    if (chosen == data.chosen) return;
+    data.chosen = chosen;
+
+    std::vector<std::string> usrs;
+    if (chosen) collect_dependency_usrs(*chosen, usrs);
+
+    std::vector<vertex> edges;
+    edges.reserve(usrs.size());
+    for (const auto& usr : usrs) {
+      if (usr == vertices_[v].usr) continue;
+      vertex dep = intern(usr);  // May grow vertices_, so data is not used below
+      if (std::find(edges.begin(), edges.end(), dep) == edges.end()) edges.push_back(dep);
+    }
+    vertices_[v].edges = std::move(edges);
+  }
+
+  void type_graph::add(const node_ptr& root) {
+    std::vector<vertex> touched;
+    for (auto& decl : collect_types(root)) {
+      vertex v = intern(decl->get_usr());
+      vertices_[v].declarations.push_back({root.get(), std::move(decl)});
+      touched.push_back(v);
+    }
+    for (auto v : touched) refresh(v);
+  }
+
+  void type_graph::remove(const node_ptr& root) {
+    if (!root) return;
+    std::vector<vertex> touched;
+    for (const auto& decl : collect_types(root)) {
+      auto it = by_usr_.find(decl->get_usr());
+      if (it == by_usr_.end()) continue;
+      auto& decls = vertices_[it->second].declarations;
+      auto removed = std::remove_if(decls.begin(), decls.end(), [&](const declaration& d) { return d.root == root.get(); });
+      if (removed != decls.end()) {
+        decls.erase(removed, decls.end());
+        touched.push_back(it->second);
+      }
+    }
+    for (auto v : touched) refresh(v);
+  }
+
+  void type_graph::update(const node_ptr& old_root, const node_ptr& new_root) {
+    remove(old_root);
+    add(new_root);
+  }
+
+  // ============================================================================
+  // Vertices
+  // ============================================================================
+
+  bool type_graph::is_declared(vertex v) const {
+    return v < vertices_.size() && vertices_[v].chosen != nullptr;
+  }
+
+  std::size_t type_graph::size() const {
+    return static_cast<std::size_t>(std::count_if(vertices_.begin(), vertices_.end(), [](const vertex_data& d) { return d.chosen != nullptr; }));
+  }
+
+  std::vector<type_graph::vertex> type_graph::get_vertices() const {
+    std::vector<vertex> result;
+    for (vertex v = 0; v < vertices_.size(); ++v) {
+      if (is_declared(v)) result.push_back(v);
+    }
+    return result;
+  }
+
+  type_graph::vertex type_graph::find(const std::string& usr) const {
+    auto it = by_usr_.find(usr);
+    return it != by_usr_.end() && is_declared(it->second) ? it->second : invalid_vertex;
+  }
+
+  type_graph::vertex type_graph::find(const node_ptr& n) const {
+    return n ? find(n->get_usr()) : invalid_vertex;
+  }
+
+  node_ptr type_graph::get_node(vertex v) const {
+    return v < vertices_.size() ? vertices_[v].chosen : nullptr;
+  }
+
+  const std::string& type_graph::get_usr(vertex v) const {
+    static const std::string empty;
+    return v < vertices_.size() ? vertices_[v].usr : empty;
+  }
+
+  // ============================================================================
+  // Edges
+  // ============================================================================
+
+  std::vector<type_graph::vertex> type_graph::get_dependencies(vertex v) const {
+    std::vector<vertex> result;
+    if (!is_declared(v)) return result;
+    for (auto dep : vertices_[v].edges) {
+      if (is_declared(dep)) result.push_back(dep);
+    }
+    return result;
+  }
+
+  std::vector<type_graph::vertex> type_graph::get_dependents(vertex v) const {
+    std::vector<vertex> result;
+    if (!is_declared(v)) return result;
+    for (vertex u = 0; u < vertices_.size(); ++u) {
+      if (!is_declared(u)) continue;
+      const auto& edges = vertices_[u].edges;
+      if (std::find(edges.begin(), edges.end(), v) != edges.end()) result.push_back(u);
+    }
+    return result;
+  }
+
+  std::vector<type_graph::vertex> type_graph::get_transitive_dependencies(vertex v) const {
+    std::vector<vertex> result;
+    if (!is_declared(v)) return result;
+
+    // Iterative post-order DFS
+    std::vector<bool> visited(vertices_.size(), false);
+    std::vector<std::pair<vertex, std::size_t>> stack {{v, 0}};
+    visited[v] = true;
+    while (!stack.empty()) {
+      auto [u, pos] = stack.back();
+      const auto& edges = vertices_[u].edges;
+      if (pos < edges.size()) {
+        stack.back().second++;
+        vertex w = edges[pos];
+        if (is_declared(w) && !visited[w]) {
+          visited[w] = true;
+          stack.push_back({w, 0});
+        }
+        continue;
+      }
+      stack.pop_back();
+      if (u != v) result.push_back(u);
+    }
+    return result;
+  }
+
+  // ============================================================================
+  // Orderings
+  // ============================================================================
+
+  std::vector<std::vector<type_graph::vertex>> type_graph::get_strongly_connected_components() const {
+    // Iterative Tarjan. Components are emitted once everything they reach has
+    // been emitted, which is dependencies-first for edges pointing at dependencies.
+    constexpr std::uint32_t unvisited = static_cast<std::uint32_t>(-1);
+    const std::size_t count = vertices_.size();
+    std::vector<std::uint32_t> index(count, unvisited);
+    std::vector<std::uint32_t> low(count, 0);
+    std::vector<bool> on_stack(count, false);
+    std::vector<vertex> component_stack;
+    std::vector<std::pair<vertex, std::size_t>> call_stack;
+    std::vector<std::vector<vertex>> result;
+    std::uint32_t next_index = 0;
+
+    auto enter = [&](vertex v) {
+      index[v] = low[v] = next_index++;
+      component_stack.push_back(v);
+      on_stack[v] = true;
+      call_stack.push_back({v, 0});
+    };
+
+    for (vertex start = 0; start < count; ++start) {
+      if (!is_declared(start) || index[start] != unvisited) continue;
+      enter(start);
+
+      while (!call_stack.empty()) {
+        auto [v, pos] = call_stack.back();
+        const auto& edges = vertices_[v].edges;
+        if (pos < edges.size()) {
+          call_stack.back().second++;
+          vertex w = edges[pos];
+          if (!is_declared(w)) continue;
+          if (index[w] == unvisited) {
+            enter(w);
+          } else if (on_stack[w]) {
+            low[v] = std::min(low[v], index[w]);
+          }
+          continue;
+        }
+
+        call_stack.pop_back();
+        if (!call_stack.empty()) {
+          vertex parent = call_stack.back().first;
+          low[parent] = std::min(low[parent], low[v]);
+        }
+        if (low[v] == index[v]) {
+          std::vector<vertex> component;
+          vertex w;
+          do {
+            w = component_stack.back();
+            component_stack.pop_back();
+            on_stack[w] = false;
+            component.push_back(w);
+          } while (w != v);
+          std::sort(component.begin(), component.end());
+          result.push_back(std::move(component));
+        }
+      }
+    }
+    return result;
+  }
+
+  std::vector<type_graph::vertex> type_graph::get_topological_order() const {
+    std::vector<vertex> result;
+    for (const auto& component : get_strongly_connected_components()) {
+      result.insert(result.end(), component.begin(), component.end());
+    }
+    return result;
+  }
+
+  bool type_graph::has_cycles() const {
+    for (const auto& component : get_strongly_connected_components()) {
+      if (component.size() > 1) return true;
+    }
+    return false;
+  }
+
+}  // namespace xccmeta
@@ -84,6 +84,12 @@ namespace xccmeta {
   std::int64_t type_info::get_alignment() const {
     return alignment_;
   }
+  const std::string& type_info::get_declaration_usr() const {
+    return declaration_usr_;
+  }
+  const std::vector<std::string>& type_info::get_referenced_usrs() const {
+    return referenced_usrs_;
+  }
   bool type_info::is_valid() const {
     return !spelling_.empty();
   }
@@ -146,6 +152,14 @@ namespace xccmeta {
   void type_info::set_alignment(std::int64_t a) {
     alignment_ = a;
   }
+  void type_info::set_declaration_usr(const std::string& usr) {
+    declaration_usr_ = usr;
+  }
+  void type_info::add_referenced_usr(const std::string& usr) {
+    if (usr.empty()) return;
+    if (std::find(referenced_usrs_.begin(), referenced_usrs_.end(), usr) != referenced_usrs_.end()) return;
+    referenced_usrs_.push_back(usr);
+  }
 
   // =============================================================================
   // Utility methods
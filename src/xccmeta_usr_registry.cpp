@@ -0,0 +1,104 @@
+/*
+MIT License
+
+Copyright (c) 2026 Christian Luppi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <xccmeta/xccmeta_usr_registry.hpp>
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace xccmeta {
+
+  namespace {
+    constexpr std::size_t stripe_count = 64;
+
+    // Heterogeneous lookup, so claims by string_view don't allocate for known USRs
+    struct usr_hash {
+      using is_transparent = void;
+      std::size_t operator()(std::string_view usr) const { return std::hash<std::string_view> {}(usr); }
+    };
+  }  // namespace
+
+  struct usr_registry::stripe {
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, bool, usr_hash, std::equal_to<>> defined;  // USR -> definition claimed
+  };
+
+  usr_registry::usr_registry(): stripes_(std::make_unique<stripe[]>(stripe_count)) {}
+
+  usr_registry::~usr_registry() = default;
+
+  usr_registry::stripe& usr_registry::stripe_for(std::string_view usr) const {
+    // High bits pick the stripe; the map inside uses the low bits
+    const std::size_t hash = usr_hash {}(usr);
+    return stripes_[(hash >> 16) % stripe_count];
+  }
+
+  bool usr_registry::claim(std::string_view usr, bool is_definition) {
+    stripe& s = stripe_for(usr);
+    std::lock_guard lock(s.mutex);
+
+    auto it = s.defined.find(usr);
+    if (it == s.defined.end()) {
+      s.defined.emplace(std::string(usr), is_definition);
+      return true;
+    }
+    if (is_definition && !it->second) {
+      it->second = true;
+      return true;
+    }
+    return false;
+  }
+
+  bool usr_registry::contains(std::string_view usr) const {
+    const stripe& s = stripe_for(usr);
+    std::lock_guard lock(s.mutex);
+    return s.defined.find(usr) != s.defined.end();
+  }
+
+  bool usr_registry::has_definition(std::string_view usr) const {
+    const stripe& s = stripe_for(usr);
+    std::lock_guard lock(s.mutex);
+    auto it = s.defined.find(usr);
+    return it != s.defined.end() && it->second;
+  }
+
+  std::size_t usr_registry::size() const {
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < stripe_count; ++i) {
+      std::lock_guard lock(stripes_[i].mutex);
+      total += stripes_[i].defined.size();
+    }
+    return total;
+  }
+
+  void usr_registry::clear() {
+    for (std::size_t i = 0; i < stripe_count; ++i) {
+      std::lock_guard lock(stripes_[i].mutex);
+      stripes_[i].defined.clear();
+    }
+  }
+
+}  // namespace xccmeta
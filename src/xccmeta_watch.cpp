@@ -0,0 +1,398 @@
+/*
+MIT License
+
+Copyright (c) 2026 Christian Luppi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <xccmeta/xccmeta_watch.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+
+#if defined(__linux__)
+#  include <cerrno>
+#  include <cstdint>
+#  include <poll.h>
+#  include <sys/eventfd.h>
+#  include <sys/inotify.h>
+#  include <unistd.h>
+#  define XCCMETA_HAS_INOTIFY 1
+#endif
+
+namespace xccmeta {
+
+  namespace {
+
+    // Absolute and normalized, so paths from the importer and from libclang compare equal
+    path canonical_path(const path& p) {
+      std::error_code ec;
+      path result = std::filesystem::weakly_canonical(p.empty() ? path(".") : p, ec);
+      if (ec) result = std::filesystem::absolute(p, ec).lexically_normal();
+      if (!result.has_filename() && result.has_parent_path()) result = result.parent_path();  // "dir/" -> "dir"
+      return result;
+    }
+
+    bool is_under(const path& p, const path& dir) {
+      return std::mismatch(dir.begin(), dir.end(), p.begin(), p.end()).first == dir.end();
+    }
+
+    void collect_location_files(const node& n, std::set<std::string>& out) {
+      out.insert(n.get_location().file);
+      for (const auto& child : n.get_children()) collect_location_files(*child, out);
+    }
+
+    // Directories a pattern could find files in, so created files are noticed
+    void collect_pattern_dirs(const glob& g, const std::vector<glob>& excludes, const path& dir,
+                              std::set<path>& out) {
+      out.insert(canonical_path(dir));
+      std::error_code ec;
+      std::filesystem::directory_iterator it(dir.empty() ? path(".") : dir, ec);
+      for (; !ec && it != std::filesystem::directory_iterator(); it.increment(ec)) {
+        std::error_code status_ec;
+        if (!it->is_directory(status_ec) || it->is_symlink(status_ec)) continue;
+        const path child = dir / it->path().filename();
+        if (g.may_match_below(child) &&
+            std::none_of(excludes.begin(), excludes.end(), [&](const glob& x) { return x.matches_all_below(child); })) {
+          collect_pattern_dirs(g, excludes, child, out);
+        }
+      }
+    }
+
+  }  // namespace
+
+  struct watcher::state {
+    int inotify_fd = -1;
+    int wake_fd = -1;  // Written by stop() to wake poll()
+    std::unordered_map<int, path> watches;  // Watch descriptor -> directory
+    std::set<path> watched_dirs;
+
+    std::atomic<bool> stopped {false};
+    std::mutex mutex;  // Only for waiting without file events
+    std::condition_variable wake;
+
+    std::vector<path> dependency_bases;  // Canonical directories whose headers are tracked
+    manifest inputs;                     // Inputs as of the last update
+    manifest headers;                    // Tracked headers that are not inputs
+
+    // Written by update() only; get_root() and get_dependencies() read them from other threads
+    mutable std::mutex trees_mutex;
+    std::map<path, node_ptr> roots;                  // Input -> tree
+    std::map<path, std::vector<path>> dependencies;  // Input -> canonical headers
+    std::map<path, std::set<path>> dependents;       // Canonical header -> inputs
+  };
+
+  watcher::watcher(const config& cfg): config_(cfg), state_(std::make_unique<state>()) {
+    // The watcher keeps its own in-memory manifest
+    config_.inputs.manifest_path.clear();
+    config_.inputs.only_changed = false;
+
+    for (const auto& pattern : config_.inputs.patterns) {
+      state_->dependency_bases.push_back(canonical_path(glob(pattern).get_base()));
+    }
+    for (const auto& dir : config_.dependency_dirs) {
+      state_->dependency_bases.push_back(canonical_path(dir));
+    }
+
+#if defined(XCCMETA_HAS_INOTIFY)
+    state_->inotify_fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    state_->wake_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+#endif
+  }
+
+  watcher::~watcher() {
+#if defined(XCCMETA_HAS_INOTIFY)
+    if (state_->inotify_fd >= 0) ::close(state_->inotify_fd);
+    if (state_->wake_fd >= 0) ::close(state_->wake_fd);
+#endif
+  }
+
+  bool watcher::is_supported() {
+#if defined(XCCMETA_HAS_INOTIFY)
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  bool watcher::update() {
+    state& s = *state_;
+    const unsigned thread_count = config_.inputs.thread_count;
+
+    importer imp(config_.inputs);
+    manifest input_scan = manifest::scan(imp.get_files(), &s.inputs, thread_count);
+    const manifest::changes input_changes = input_scan.diff(s.inputs);
+
+    std::set<path> canonical_inputs;
+    for (const auto& e : input_scan.get_entries()) canonical_inputs.insert(canonical_path(e.file_path));
+
+    std::set<path> previously_tracked;
+    std::vector<file> tracked_headers;
+    for (const auto& [header, users] : s.dependents) {
+      if (canonical_inputs.count(header)) continue;
+      previously_tracked.insert(header);
+      tracked_headers.emplace_back(header);
+    }
+    const manifest header_scan = manifest::scan(tracked_headers, &s.headers, thread_count);
+    const manifest::changes header_changes = header_scan.diff(s.headers);
+
+    // Changed inputs, plus every input whose tree includes a changed file
+    std::set<path> to_parse;
+    auto parse_users_of = [&](const path& changed) {
+      auto it = s.dependents.find(canonical_path(changed));
+      if (it != s.dependents.end()) to_parse.insert(it->second.begin(), it->second.end());
+    };
+    for (const auto& f : input_changes.changed) {
+      to_parse.insert(f.get_path());
+      parse_users_of(f.get_path());
+    }
+    for (const auto& f : input_changes.added) {
+      to_parse.insert(f.get_path());
+      parse_users_of(f.get_path());
+    }
+    for (const auto& f : header_changes.changed) parse_users_of(f.get_path());
+    for (const auto& p : input_changes.removed) parse_users_of(p);
+    for (const auto& p : header_changes.removed) parse_users_of(p);
+
+    batch changes;
+    for (const auto& p : input_changes.removed) {
+      to_parse.erase(p);
+      if (auto it = s.dependencies.find(p); it != s.dependencies.end()) {
+        for (const auto& header : it->second) s.dependents[header].erase(p);
+      }
+      std::lock_guard lock(s.trees_mutex);
+      s.roots.erase(p);
+      s.dependencies.erase(p);
+      changes.removed.push_back(p);
+    }
+
+    std::vector<file> files(to_parse.begin(), to_parse.end());
+    std::vector<node_ptr> roots = parse_pipeline(config_.pipeline).run(files, config_.args);
+    std::vector<node_ptr> parsed_roots;
+    for (std::size_t i = 0; i < files.size(); ++i) {
+      if (!roots[i]) continue;  // Unreadable; retried when it changes again
+      const path& input = files[i].get_path();
+      const path self = canonical_path(input);
+
+      if (auto it = s.dependencies.find(input); it != s.dependencies.end()) {
+        for (const auto& header : it->second) s.dependents[header].erase(input);
+      }
+      std::vector<path> deps;
+
+      std::set<std::string> location_files;
+      collect_location_files(*roots[i], location_files);
+      for (const auto& name : location_files) {
+        if (name.empty() || name == roots[i]->get_name()) continue;  // No location, or the parsed input itself
+        path header = canonical_path(name);
+        if (header == self) continue;
+        if (std::none_of(s.dependency_bases.begin(), s.dependency_bases.end(),
+                         [&](const path& base) { return is_under(header, base); })) {
+          continue;  // System and third-party headers are not watched
+        }
+        s.dependents[header].insert(input);
+        deps.push_back(std::move(header));
+      }
+      std::sort(deps.begin(), deps.end());
+
+      {
+        std::lock_guard lock(s.trees_mutex);
+        s.dependencies[input] = std::move(deps);
+        s.roots[input] = roots[i];
+      }
+      changes.parsed.push_back(files[i]);
+      parsed_roots.push_back(roots[i]);
+    }
+
+    for (auto it = s.dependents.begin(); it != s.dependents.end();) {
+      it = it->second.empty() ? s.dependents.erase(it) : std::next(it);
+    }
+
+    // Record the headers the trees now depend on, so the next update compares against
+    // them. Headers tracked before the parse keep their pre-parse state, so one saved
+    // during the parse still differs next time; only newly found headers are scanned.
+    std::vector<file> still_tracked;
+    std::vector<file> new_headers;
+    for (const auto& [header, users] : s.dependents) {
+      if (canonical_inputs.count(header)) continue;
+      (previously_tracked.count(header) ? still_tracked : new_headers).emplace_back(header);
+    }
+    s.headers = header_scan.select(still_tracked);
+    s.headers.merge(manifest::scan(new_headers, nullptr, thread_count));
+    s.inputs = std::move(input_scan);
+
+    watch_directories();
+
+    if (changes.parsed.empty() && changes.removed.empty()) {
+      return false;
+    }
+    if (config_.on_parsed) {
+      for (std::size_t i = 0; i < changes.parsed.size(); ++i) config_.on_parsed(changes.parsed[i], parsed_roots[i]);
+    }
+    if (config_.on_removed) {
+      for (const auto& p : changes.removed) config_.on_removed(p);
+    }
+    if (config_.on_batch) {
+      config_.on_batch(changes);
+    }
+    return true;
+  }
+
+  bool watcher::poll(std::chrono::milliseconds timeout) {
+    state& s = *state_;
+    if (s.stopped) return false;
+
+#if defined(XCCMETA_HAS_INOTIFY)
+    if (s.inotify_fd >= 0 && s.wake_fd >= 0) {
+      // True once file events are readable; false on timeout or stop()
+      auto wait = [&](std::chrono::milliseconds duration) {
+        pollfd fds[2] = {{s.inotify_fd, POLLIN, 0}, {s.wake_fd, POLLIN, 0}};
+        const auto ms = std::clamp<std::chrono::milliseconds::rep>(duration.count(), 0, INT_MAX);
+        for (;;) {
+          const int ready = ::poll(fds, 2, static_cast<int>(ms));
+          if (ready < 0 && errno == EINTR) continue;
+          return ready > 0 && !(fds[1].revents & POLLIN) && !s.stopped;
+        }
+      };
+
+      if (!wait(timeout) || !drain_events()) return false;
+
+      // Saving a file often takes several writes and renames; wait for them to settle,
+      // but not past max_delay, so a file that is rewritten constantly still updates
+      const auto deadline = std::chrono::steady_clock::now() + config_.max_delay;
+      for (;;) {
+        const auto left = std::chrono::ceil<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        if (left <= std::chrono::milliseconds::zero() || !wait(std::min(config_.debounce, left))) break;
+        drain_events();
+      }
+      if (s.stopped) return false;
+      return update();
+    }
+#endif
+
+    std::unique_lock lock(s.mutex);
+    s.wake.wait_for(lock, timeout, [&] { return s.stopped.load(); });
+    return false;
+  }
+
+  void watcher::run() {
+    update();
+    while (!state_->stopped) {
+      if (is_supported() && state_->inotify_fd >= 0) {
+        poll(std::chrono::hours(1));
+      } else {
+        poll(std::chrono::seconds(1));
+        if (!state_->stopped) update();
+      }
+    }
+  }
+
+  void watcher::stop() {
+    state_->stopped = true;
+#if defined(XCCMETA_HAS_INOTIFY)
+    if (state_->wake_fd >= 0) {
+      const std::uint64_t one = 1;
+      [[maybe_unused]] const ssize_t written = ::write(state_->wake_fd, &one, sizeof(one));
+    }
+#endif
+    {
+      std::lock_guard lock(state_->mutex);  // A waiter between its check and its wait cannot miss this
+    }
+    state_->wake.notify_all();
+  }
+
+  node_ptr watcher::get_root(const path& input) const {
+    std::lock_guard lock(state_->trees_mutex);
+    auto it = state_->roots.find(input);
+    return it != state_->roots.end() ? it->second : nullptr;
+  }
+
+  std::vector<path> watcher::get_dependencies(const path& input) const {
+    std::lock_guard lock(state_->trees_mutex);
+    auto it = state_->dependencies.find(input);
+    return it != state_->dependencies.end() ? it->second : std::vector<path> {};
+  }
+
+  bool watcher::drain_events() {
+    bool any = false;
+#if defined(XCCMETA_HAS_INOTIFY)
+    state& s = *state_;
+    alignas(inotify_event) char buffer[16384];
+    for (;;) {
+      const ssize_t n = ::read(s.inotify_fd, buffer, sizeof(buffer));
+      if (n < 0 && errno == EINTR) continue;
+      if (n <= 0) break;  // EAGAIN: queue drained
+
+      for (const char* p = buffer; p < buffer + n;) {
+        const auto* event = reinterpret_cast<const inotify_event*>(p);
+        if (event->mask & IN_IGNORED) {
+          // Directory deleted or moved away; watch it again if it comes back
+          auto it = s.watches.find(event->wd);
+          if (it != s.watches.end()) {
+            s.watched_dirs.erase(it->second);
+            s.watches.erase(it);
+          }
+        } else {
+          any = true;
+        }
+        p += sizeof(inotify_event) + event->len;
+      }
+    }
+#endif
+    return any;
+  }
+
+  void watcher::watch_directories() {
+#if defined(XCCMETA_HAS_INOTIFY)
+    state& s = *state_;
+    if (s.inotify_fd < 0) return;
+
+    std::set<path> dirs;
+    for (const auto& [input, root] : s.roots) dirs.insert(canonical_path(input).parent_path());
+    for (const auto& [header, users] : s.dependents) dirs.insert(header.parent_path());
+
+    std::vector<glob> excludes(config_.inputs.exclude_patterns.begin(), config_.inputs.exclude_patterns.end());
+    for (const auto& pattern : config_.inputs.patterns) {
+      const glob g(pattern);
+      if (g.is_literal()) {
+        dirs.insert(canonical_path(g.get_base()));
+      } else {
+        collect_pattern_dirs(g, excludes, g.get_base(), dirs);
+      }
+    }
+
+    constexpr std::uint32_t mask = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+    for (const auto& dir : dirs) {
+      if (s.watched_dirs.count(dir)) continue;
+      const int wd = ::inotify_add_watch(s.inotify_fd, dir.c_str(), mask);
+      if (wd < 0) continue;  // Missing, or out of watches
+      s.watches[wd] = dir;
+      s.watched_dirs.insert(dir);
+    }
+#endif
+  }
+
+}  // namespace xccmeta
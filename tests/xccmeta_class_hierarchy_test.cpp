@@ -0,0 +1,186 @@
+/*
+MIT License
+
+Copyright (c) 2026 Christian Luppi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <xccmeta/xccmeta_class_hierarchy.hpp>
+#include <xccmeta/xccmeta_parser.hpp>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace {
+
+  // ============================================================================
+  // Test Fixture
+  // ============================================================================
+
+  class ClassHierarchyTest : public ::testing::Test {
+   protected:
+    xccmeta::parser p;
+    xccmeta::compile_args args = xccmeta::compile_args::modern_cxx();
+    xccmeta::node_ptr root;
+
+    void SetUp() override {
+      root = p.parse(R"(
+        struct Component { virtual ~Component() = default; };
+        struct Renderable : Component {};
+        struct Physics : Component {};
+        struct Sprite : Renderable {};
+        struct Body final : Physics {};
+        struct Unrelated {};
+
+        struct Base { int id; };
+        struct Left : virtual Base {};
+        struct Right : virtual Base {};
+        struct Diamond : Left, Right {};
+        class Secret : private Unrelated {};
+      )",
+                     args);
+      ASSERT_NE(root, nullptr);
+    }
+
+    std::vector<std::string> names(const xccmeta::class_hierarchy& h, const std::vector<xccmeta::class_hierarchy::class_id>& ids) {
+      std::vector<std::string> result;
+      for (auto id : ids) result.push_back(h.get_node(id)->get_name());
+      std::sort(result.begin(), result.end());
+      return result;
+    }
+
+    xccmeta::class_hierarchy::class_id id(const xccmeta::class_hierarchy& h, const std::string& name) {
+      return h.find("c:@S@" + name);
+    }
+  };
+
+  // ============================================================================
+  // Direct relations
+  // ============================================================================
+
+  TEST_F(ClassHierarchyTest, IndexesRecords) {
+    xccmeta::class_hierarchy h(root);
+    EXPECT_EQ(h.size(), 11u);
+    EXPECT_EQ(h.find("c:@S@Missing"), xccmeta::class_hierarchy::invalid_class);
+    EXPECT_EQ(h.get_node(xccmeta::class_hierarchy::invalid_class), nullptr);
+  }
+
+  TEST_F(ClassHierarchyTest, DirectBasesAndDerived) {
+    xccmeta::class_hierarchy h(root);
+    auto component = id(h, "Component");
+    std::vector<xccmeta::class_hierarchy::class_id> derived(h.get_derived(component).begin(), h.get_derived(component).end());
+    EXPECT_EQ(names(h, derived), (std::vector<std::string> {"Physics", "Renderable"}));
+
+    auto bases = h.get_bases(id(h, "Diamond"));
+    ASSERT_EQ(bases.size(), 2u);
+    EXPECT_EQ(h.get_node(bases[0].base)->get_name(), "Left");
+    EXPECT_EQ(h.get_node(bases[1].base)->get_name(), "Right");
+    EXPECT_FALSE(bases[0].is_virtual);
+
+    auto secret_bases = h.get_bases(h.find("c:@S@Secret"));
+    ASSERT_EQ(secret_bases.size(), 1u);
+    EXPECT_EQ(secret_bases[0].access, xccmeta::access_specifier::private_);
+  }
+
+  // ============================================================================
+  // Transitive relations
+  // ============================================================================
+
+  TEST_F(ClassHierarchyTest, AllDerivedIsTransitive) {
+    xccmeta::class_hierarchy h(root);
+    EXPECT_EQ(names(h, h.get_all_derived(id(h, "Component"))), (std::vector<std::string> {"Body", "Physics", "Renderable", "Sprite"}));
+    EXPECT_EQ(names(h, h.get_all_bases(id(h, "Sprite"))), (std::vector<std::string> {"Component", "Renderable"}));
+    EXPECT_EQ(names(h, h.get_all_derived(id(h, "Unrelated"))), (std::vector<std::string> {"Secret"}));
+  }
+
+  TEST_F(ClassHierarchyTest, IsDerivedFrom) {
+    xccmeta::class_hierarchy h(root);
+    EXPECT_TRUE(h.is_derived_from(id(h, "Sprite"), id(h, "Component")));
+    EXPECT_TRUE(h.is_derived_from(id(h, "Diamond"), id(h, "Base")));
+    EXPECT_FALSE(h.is_derived_from(id(h, "Component"), id(h, "Sprite")));
+    EXPECT_FALSE(h.is_derived_from(id(h, "Sprite"), id(h, "Sprite")));
+    EXPECT_FALSE(h.is_derived_from(id(h, "Body"), id(h, "Renderable")));
+  }
+
+  TEST_F(ClassHierarchyTest, MultipleInheritanceBelowAndAbove) {
+    auto tree = p.parse(R"(
+      struct A {};
+      struct B : A {};
+      struct C : B {};
+      struct M {};
+      struct Mixed : C, M {};
+      struct Leaf : Mixed {};
+      struct Twice : Leaf, B {};
+      struct Tip : Twice {};
+    )",
+                        args);
+    xccmeta::class_hierarchy h(tree);
+    EXPECT_TRUE(h.is_derived_from(id(h, "Leaf"), id(h, "A")));
+    EXPECT_TRUE(h.is_derived_from(id(h, "Tip"), id(h, "M")));
+    EXPECT_TRUE(h.is_derived_from(id(h, "Tip"), id(h, "Mixed")));
+    EXPECT_FALSE(h.is_derived_from(id(h, "Mixed"), id(h, "Leaf")));
+    EXPECT_FALSE(h.is_derived_from(id(h, "C"), id(h, "M")));
+
+    EXPECT_EQ(names(h, h.get_all_derived(id(h, "A"))), (std::vector<std::string> {"B", "C", "Leaf", "Mixed", "Tip", "Twice"}));
+    EXPECT_EQ(names(h, h.get_all_derived(id(h, "M"))), (std::vector<std::string> {"Leaf", "Mixed", "Tip", "Twice"}));
+    EXPECT_EQ(names(h, h.get_all_bases(id(h, "Tip"))), (std::vector<std::string> {"A", "B", "C", "Leaf", "M", "Mixed", "Twice"}));
+    EXPECT_EQ(names(h, h.get_all_bases(id(h, "Leaf"))), (std::vector<std::string> {"A", "B", "C", "M", "Mixed"}));
+  }
+
+  TEST_F(ClassHierarchyTest, VirtualBasesPropagate) {
+    xccmeta::class_hierarchy h(root);
+    auto base = id(h, "Base");
+    EXPECT_TRUE(h.is_virtual_base_of(base, id(h, "Left")));
+    EXPECT_TRUE(h.is_virtual_base_of(base, id(h, "Diamond")));
+    EXPECT_FALSE(h.is_virtual_base_of(id(h, "Left"), id(h, "Diamond")));
+    EXPECT_FALSE(h.is_virtual_base_of(id(h, "Component"), id(h, "Sprite")));
+    EXPECT_EQ(names(h, h.get_virtual_bases(id(h, "Diamond"))), (std::vector<std::string> {"Base"}));
+  }
+
+  // ============================================================================
+  // Multiple translation units
+  // ============================================================================
+
+  TEST_F(ClassHierarchyTest, LinksAcrossTranslationUnits) {
+    auto other = p.parse(R"(
+      struct Component { virtual ~Component() = default; };
+      struct Audio : Component {};
+    )",
+                         args);
+    xccmeta::class_hierarchy h(std::vector<xccmeta::node_ptr> {root, other});
+    auto component = id(h, "Component");
+    EXPECT_EQ(names(h, h.get_all_derived(component)), (std::vector<std::string> {"Audio", "Body", "Physics", "Renderable", "Sprite"}));
+  }
+
+  TEST_F(ClassHierarchyTest, ManyClassesSpanSeveralWords) {
+    std::string code = "struct Root {};\n";
+    for (int i = 0; i < 150; ++i) {
+      code += "struct D" + std::to_string(i) + " : " + (i == 0 ? std::string("Root") : "D" + std::to_string(i - 1)) + " {};\n";
+    }
+    xccmeta::class_hierarchy h(p.parse(code, args));
+    ASSERT_EQ(h.size(), 151u);
+    EXPECT_EQ(h.get_all_derived(id(h, "Root")).size(), 150u);
+    EXPECT_EQ(h.get_all_bases(id(h, "D149")).size(), 150u);
+    EXPECT_TRUE(h.is_derived_from(id(h, "D149"), id(h, "D70")));
+  }
+
+}  // namespace
@@ -0,0 +1,185 @@
+/*
+MIT License
+
+Copyright (c) 2026 Christian Luppi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <xccmeta/xccmeta_diff.hpp>
+#include <xccmeta/xccmeta_parser.hpp>
+
+#include <string>
+#include <vector>
+
+namespace {
+
+  using op = xccmeta::diff_entry::operation;
+
+  // ============================================================================
+  // Test Fixture
+  // ============================================================================
+
+  class DiffTest : public ::testing::Test {
+   protected:
+    xccmeta::parser p;
+    xccmeta::compile_args args = xccmeta::compile_args::modern_cxx();
+
+    std::vector<xccmeta::diff_entry> run(const std::string& before, const std::string& after,
+                                         const xccmeta::diff_options& options = {}) {
+      auto a = p.parse(before, args);
+      auto b = p.parse(after, args);
+      EXPECT_NE(a, nullptr);
+      EXPECT_NE(b, nullptr);
+      return xccmeta::diff(a, b, options);
+    }
+
+    static const xccmeta::diff_entry* find(const std::vector<xccmeta::diff_entry>& entries, op o, const std::string& name) {
+      for (const auto& e : entries) {
+        const auto& n = e.new_node ? e.new_node : e.old_node;
+        if (e.op == o && n->get_name() == name) return &e;
+      }
+      return nullptr;
+    }
+  };
+
+  // ============================================================================
+  // Identity
+  // ============================================================================
+
+  TEST_F(DiffTest, IdenticalInputsHaveNoEntries) {
+    const char* code = "struct A { int x; }; enum class E { One, Two };";
+    EXPECT_TRUE(run(code, code).empty());
+  }
+
+  TEST_F(DiffTest, MovedDeclarationsOnlyDifferWithLocations) {
+    const char* before = "struct A { int x; };";
+    const char* after = "\n\nstruct A { int x; };";
+    EXPECT_TRUE(run(before, after).empty());
+
+    xccmeta::diff_options options;
+    options.include_locations = true;
+    auto entries = run(before, after, options);
+    auto a = find(entries, op::changed, "A");
+    ASSERT_NE(a, nullptr);
+    EXPECT_TRUE(xccmeta::has_change(a->changes, xccmeta::change::location));
+  }
+
+  TEST_F(DiffTest, NullRoots) {
+    auto root = p.parse("struct A {};", args);
+    EXPECT_TRUE(xccmeta::diff(nullptr, nullptr).empty());
+
+    auto added = xccmeta::diff(nullptr, root);
+    ASSERT_EQ(added.size(), 1u);
+    EXPECT_EQ(added[0].op, op::added);
+
+    auto removed = xccmeta::diff(root, nullptr);
+    ASSERT_EQ(removed.size(), 1u);
+    EXPECT_EQ(removed[0].op, op::removed);
+  }
+
+  // ============================================================================
+  // Edit script
+  // ============================================================================
+
+  TEST_F(DiffTest, AddedAndRemovedDeclarations) {
+    auto entries = run("struct Keep {}; struct Gone { int x; };", "struct Keep {}; struct Fresh {};");
+
+    auto gone = find(entries, op::removed, "Gone");
+    ASSERT_NE(gone, nullptr);
+    EXPECT_EQ(gone->new_node, nullptr);
+
+    auto fresh = find(entries, op::added, "Fresh");
+    ASSERT_NE(fresh, nullptr);
+    EXPECT_EQ(fresh->old_node, nullptr);
+
+    EXPECT_EQ(find(entries, op::changed, "Keep"), nullptr);
+    EXPECT_EQ(find(entries, op::removed, "x"), nullptr);  // Subtrees are reported once
+  }
+
+  TEST_F(DiffTest, ChangeMasksNameTheAttributes) {
+    auto entries = run(R"(
+      struct S {
+        int count;
+        /// @reflect
+        float speed;
+        virtual void tick();
+      };
+    )",
+                       R"(
+      struct S {
+        long count;
+        /// @reflect(fast)
+        float speed;
+        void tick();
+      };
+    )");
+
+    auto count = find(entries, op::changed, "count");
+    ASSERT_NE(count, nullptr);
+    EXPECT_EQ(count->changes, static_cast<xccmeta::change_mask>(xccmeta::change::type));
+
+    auto speed = find(entries, op::changed, "speed");
+    ASSERT_NE(speed, nullptr);
+    EXPECT_TRUE(xccmeta::has_change(speed->changes, xccmeta::change::tags));
+    EXPECT_TRUE(xccmeta::has_change(speed->changes, xccmeta::change::comment));
+
+    auto tick = find(entries, op::changed, "tick");
+    ASSERT_NE(tick, nullptr);
+    EXPECT_TRUE(xccmeta::has_change(tick->changes, xccmeta::change::flags));
+
+    // S itself only changed through its members
+    EXPECT_EQ(find(entries, op::changed, "S"), nullptr);
+  }
+
+  TEST_F(DiffTest, ParentReportsChildSetChanges) {
+    auto entries = run("struct S { int a; int b; };", "struct S { int b; int a; int c; };");
+
+    auto s = find(entries, op::changed, "S");
+    ASSERT_NE(s, nullptr);
+    EXPECT_TRUE(xccmeta::has_change(s->changes, xccmeta::change::children));
+    EXPECT_TRUE(xccmeta::has_change(s->changes, xccmeta::change::type));  // sizeof(S) grew
+    ASSERT_NE(find(entries, op::added, "c"), nullptr);
+    EXPECT_EQ(find(entries, op::changed, "a"), nullptr);
+  }
+
+  TEST_F(DiffTest, FallbackKeyMatchesDeclarationsWithoutUsr) {
+    // Base specifiers have no USR; they pair up by kind and name
+    const char* before = "struct A {}; struct B {}; struct S : A {};";
+    EXPECT_TRUE(run(before, before).empty());
+
+    auto entries = run(before, "struct A {}; struct B {}; struct S : A, B {};");
+    std::size_t added_bases = 0;
+    for (const auto& e : entries) {
+      EXPECT_NE(e.op, op::removed);
+      if (e.op == op::added && e.new_node->get_kind() == xccmeta::node::kind::base_specifier) added_bases++;
+    }
+    EXPECT_EQ(added_bases, 1u);
+  }
+
+  TEST_F(DiffTest, EntriesFollowOldTreeOrder) {
+    auto entries = run("struct A { int x; }; struct B { int y; };", "struct A { long x; }; struct B { long y; };");
+    std::vector<std::string> names;
+    for (const auto& e : entries) names.push_back(e.old_node->get_name());
+    // Records changed too (sizeof grew); parents precede their members
+    EXPECT_EQ(names, (std::vector<std::string> {"A", "x", "B", "y"}));
+  }
+
+}  // namespace
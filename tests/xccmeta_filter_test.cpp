@@ -678,4 +678,400 @@ namespace {
     EXPECT_EQ(list.size(), 1);
   }
 
+  // ============================================================================
+  // USR Index Tests
+  // ============================================================================
+
+  TEST_F(FilterTest, ManyTypesKeepInsertionOrder) {
+    std::string code;
+    for (int i = 0; i < 300; ++i) code += "struct S" + std::to_string(i) + " {};\n";
+    auto root = parse(code);
+    ASSERT_NE(root, nullptr);
+
+    xccmeta::filter list;
+    for (const auto& child : root->get_children()) EXPECT_TRUE(list.add(child));
+    for (const auto& child : root->get_children()) EXPECT_FALSE(list.add(child));
+    ASSERT_EQ(list.size(), 300);
+
+    const std::vector<xccmeta::node_ptr> types(list.begin(), list.end());
+    ASSERT_EQ(types.size(), 300);
+    for (std::size_t i = 0; i < types.size(); ++i) {
+      EXPECT_EQ(types[i], root->get_children()[i]);
+    }
+  }
+
+  TEST_F(FilterTest, RemoveKeepsOrderOfRemainingTypes) {
+    std::string code;
+    for (int i = 0; i < 100; ++i) code += "struct S" + std::to_string(i) + " {};\n";
+    auto root = parse(code);
+    ASSERT_NE(root, nullptr);
+    const auto& children = root->get_children();
+
+    xccmeta::filter list;
+    for (const auto& child : children) list.add(child);
+    for (std::size_t i = 0; i < children.size(); i += 2) EXPECT_TRUE(list.remove(children[i]));
+
+    EXPECT_EQ(list.size(), 50);
+    EXPECT_FALSE(list.contains(children[0]));
+    EXPECT_TRUE(list.contains(children[1]));
+    EXPECT_FALSE(list.remove(children[0]));
+
+    std::vector<xccmeta::node_ptr> remaining(list.begin(), list.end());
+    ASSERT_EQ(remaining.size(), 50);
+    for (std::size_t i = 0; i < remaining.size(); ++i) {
+      EXPECT_EQ(remaining[i], children[i * 2 + 1]);
+    }
+
+    // Re-adding appends at the end
+    EXPECT_TRUE(list.add(children[0]));
+    EXPECT_EQ(list.get_types().back(), children[0]);
+    EXPECT_EQ(list.size(), 51);
+  }
+
+  TEST_F(FilterTest, ConstViewSkipsRemovedEntries) {
+    auto root = parse("struct A {}; struct B {}; struct C {}; struct D {}; struct E {};");
+    ASSERT_NE(root, nullptr);
+    const auto& children = root->get_children();
+
+    xccmeta::filter list;
+    for (const auto& child : children) list.add(child);
+    EXPECT_TRUE(list.remove(children[0]));
+    EXPECT_TRUE(list.remove(children[4]));  // Below the compaction threshold: holes remain
+
+    const xccmeta::filter& view = list;
+    const auto types = view.get_types();
+    EXPECT_EQ(types.size(), 3);
+    EXPECT_EQ(types.front(), children[1]);
+    EXPECT_EQ(types.back(), children[3]);
+    EXPECT_EQ(std::vector<xccmeta::node_ptr>(view.begin(), view.end()),
+              (std::vector<xccmeta::node_ptr> {children[1], children[2], children[3]}));
+    EXPECT_EQ(std::distance(types.begin(), types.end()), 3);
+
+    EXPECT_TRUE(list.remove(children[2]));  // Now most entries are holes
+    EXPECT_EQ(std::vector<xccmeta::node_ptr>(list.begin(), list.end()),
+              (std::vector<xccmeta::node_ptr> {children[1], children[3]}));
+    EXPECT_TRUE(list.contains(children[3]));
+  }
+
+  TEST_F(FilterTest, ContainsMatchesByUsrAcrossParses) {
+    auto first = find_descendant_by_name(parse("struct Shared {};"), "Shared");
+    auto second = find_descendant_by_name(parse("struct Other {}; struct Shared {};"), "Shared");
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+
+    xccmeta::filter list;
+    list.add(first);
+    EXPECT_TRUE(list.contains(second));
+    EXPECT_FALSE(list.add(second));
+    EXPECT_TRUE(list.remove(second));
+    EXPECT_TRUE(list.empty());
+  }
+
+  // ============================================================================
+  // add_tree Tests
+  // ============================================================================
+
+  std::vector<std::string> type_names(const xccmeta::filter& list) {
+    std::vector<std::string> names;
+    for (const auto& type : list) names.push_back(type->get_name());
+    return names;
+  }
+
+  TEST_F(FilterTest, AddTreeCollectsMatchingTypesInPreorder) {
+    auto root = parse(R"(
+      namespace game {
+        /// @reflect
+        struct Player { int hp; };
+        struct Hidden {};
+        namespace ui {
+          /// @reflect
+          enum class Anchor { Left, Right };
+          /// @reflect
+          class Button {};
+        }
+      }
+      /// @reflect
+      void not_a_type();
+    )");
+    ASSERT_NE(root, nullptr);
+
+    xccmeta::filter::config cfg;
+    cfg.grab_tag_names = {"reflect"};
+    cfg.allowed_kinds = {xccmeta::node::kind::struct_decl, xccmeta::node::kind::class_decl};
+
+    xccmeta::filter list(cfg);
+    EXPECT_EQ(list.add_tree(root), 2);
+    EXPECT_EQ(type_names(list), (std::vector<std::string> {"Player", "Button"}));
+    EXPECT_EQ(list.add_tree(root), 0);  // Already present
+  }
+
+  TEST_F(FilterTest, AddTreeChildInclusion) {
+    const char* code = R"(
+      /// @reflect
+      struct Outer {
+        struct Inner {
+          struct Deep {};
+        };
+        enum Mode { A, B };
+        /// @skip
+        struct Internal {};
+      };
+      struct Unrelated { struct Nested {}; };
+    )";
+    auto root = parse(code);
+    ASSERT_NE(root, nullptr);
+
+    xccmeta::filter::config cfg;
+    cfg.grab_tag_names = {"reflect"};
+    cfg.avoid_tag_names = {"skip"};
+
+    cfg.child_node_inclusion = xccmeta::filter::config::include;
+    xccmeta::filter direct(cfg);
+    direct.add_tree(root);
+    EXPECT_EQ(type_names(direct), (std::vector<std::string> {"Outer", "Inner", "Mode"}));
+
+    cfg.child_node_inclusion = xccmeta::filter::config::include_recursively;
+    xccmeta::filter recursive(cfg);
+    recursive.add_tree(root);
+    EXPECT_EQ(type_names(recursive), (std::vector<std::string> {"Outer", "Inner", "Deep", "Mode"}));
+
+    // Inclusion still honors allowed_kinds
+    cfg.allowed_kinds = {xccmeta::node::kind::struct_decl};
+    xccmeta::filter structs_only(cfg);
+    structs_only.add_tree(root);
+    EXPECT_EQ(type_names(structs_only), (std::vector<std::string> {"Outer", "Inner", "Deep"}));
+  }
+
+  TEST_F(FilterTest, AddTreeParentInclusion) {
+    auto root = parse(R"(
+      struct Top {
+        struct Middle {
+          /// @reflect
+          struct Leaf {};
+        };
+      };
+      struct Sibling {};
+    )");
+    ASSERT_NE(root, nullptr);
+
+    xccmeta::filter::config cfg;
+    cfg.grab_tag_names = {"reflect"};
+
+    cfg.parent_node_inclusion = xccmeta::filter::config::include;
+    xccmeta::filter direct(cfg);
+    direct.add_tree(root);
+    EXPECT_EQ(type_names(direct), (std::vector<std::string> {"Middle", "Leaf"}));
+
+    cfg.parent_node_inclusion = xccmeta::filter::config::include_recursively;
+    xccmeta::filter recursive(cfg);
+    recursive.add_tree(root);
+    EXPECT_EQ(type_names(recursive), (std::vector<std::string> {"Top", "Middle", "Leaf"}));
+  }
+
+  TEST_F(FilterTest, AddTreeIsDeterministicAcrossThreadCounts) {
+    std::string code;
+    for (int i = 0; i < 40; ++i) {
+      std::string n = std::to_string(i);
+      code += "namespace ns" + n + " { /// @reflect\n struct A" + n + " { struct B" + n + " {}; }; struct C" + n + " {}; }\n";
+    }
+    auto root = parse(code);
+    ASSERT_NE(root, nullptr);
+
+    xccmeta::filter::config cfg;
+    cfg.grab_tag_names = {"reflect"};
+    cfg.child_node_inclusion = xccmeta::filter::config::include;
+
+    xccmeta::filter serial(cfg);
+    EXPECT_EQ(serial.add_tree(root, 1), 80);
+
+    for (unsigned threads : {2u, 3u, 8u, 0u}) {
+      xccmeta::filter parallel(cfg);
+      EXPECT_EQ(parallel.add_tree(root, threads), 80);
+      EXPECT_EQ(parallel.get_types(), serial.get_types());
+    }
+  }
+
+  // ============================================================================
+  // Compiled Config Tests
+  // ============================================================================
+
+  TEST_F(FilterTest, MatchesConfigWithManyInternedTags) {
+    // Enough distinct tags that bloom mask bits collide
+    std::string code;
+    for (int i = 0; i < 100; ++i) {
+      code += "/// @t" + std::to_string(i) + "\nstruct S" + std::to_string(i) + " {};\n";
+    }
+    auto root = parse(code);
+    ASSERT_NE(root, nullptr);
+
+    xccmeta::filter::config cfg;
+    cfg.grab_tag_names = {"t3", "t70"};
+    cfg.avoid_tag_names = {"t70"};
+    xccmeta::filter list(cfg);
+
+    std::vector<std::string> matched;
+    for (const auto& child : root->get_children()) {
+      if (list.matches_config(child)) matched.push_back(child->get_name());
+    }
+    EXPECT_EQ(matched, (std::vector<std::string> {"S3"}));
+  }
+
+  TEST_F(FilterTest, MatchesManyAgreesWithMatchesConfig) {
+    auto root = parse(R"(
+      /// @reflect
+      struct A {};
+      /// @reflect @internal
+      struct B {};
+      /// @reflect
+      enum E { X };
+      struct Untagged {};
+      /// @reflect
+      class C {};
+    )");
+    ASSERT_NE(root, nullptr);
+
+    xccmeta::filter::config cfg;
+    cfg.grab_tag_names = {"reflect"};
+    cfg.avoid_tag_names = {"internal"};
+    cfg.allowed_kinds = {xccmeta::node::kind::struct_decl, xccmeta::node::kind::class_decl};
+    xccmeta::filter list(cfg);
+
+    std::vector<xccmeta::node_ptr> nodes = root->get_children();
+    nodes.push_back(nullptr);
+
+    auto flags = list.matches_many(nodes);
+    ASSERT_EQ(flags.size(), nodes.size());
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+      EXPECT_EQ(flags[i], list.matches_config(nodes[i])) << i;
+    }
+    EXPECT_EQ(std::count(flags.begin(), flags.end(), true), 2);  // A, C
+    EXPECT_TRUE(list.matches_many({}).empty());
+  }
+
+  // ============================================================================
+  // Set Algebra Tests
+  // ============================================================================
+
+  class FilterSetTest : public FilterTest {
+   protected:
+    void SetUp() override {
+      root = parse("struct A {}; struct B {}; struct C {}; struct D {}; struct E {};");
+      ASSERT_NE(root, nullptr);
+    }
+
+    xccmeta::filter make(const std::vector<std::string>& names) {
+      xccmeta::filter list;
+      for (const auto& name : names) list.add(find_descendant_by_name(root, name));
+      return list;
+    }
+
+    xccmeta::node_ptr root;
+  };
+
+  TEST_F(FilterSetTest, Unite) {
+    auto a = make({"C", "A", "B"});
+    a.unite(make({"D", "A", "E"}));
+    EXPECT_EQ(type_names(a), (std::vector<std::string> {"C", "A", "B", "D", "E"}));
+    EXPECT_TRUE(a.contains(find_descendant_by_name(root, "E")));
+
+    a.unite(a);
+    EXPECT_EQ(a.size(), 5);
+  }
+
+  TEST_F(FilterSetTest, Intersect) {
+    auto a = make({"C", "A", "B", "D"});
+    a.intersect(make({"D", "C", "E"}));
+    EXPECT_EQ(type_names(a), (std::vector<std::string> {"C", "D"}));
+    EXPECT_FALSE(a.contains(find_descendant_by_name(root, "A")));
+
+    a.intersect(xccmeta::filter {});
+    EXPECT_TRUE(a.empty());
+  }
+
+  TEST_F(FilterSetTest, Subtract) {
+    auto a = make({"A", "B", "C", "D"});
+    a.subtract(make({"B", "E", "D"}));
+    EXPECT_EQ(type_names(a), (std::vector<std::string> {"A", "C"}));
+    EXPECT_TRUE(a.add(find_descendant_by_name(root, "B")));  // Index stays consistent
+
+    a.subtract(a);
+    EXPECT_TRUE(a.empty());
+  }
+
+  TEST_F(FilterSetTest, SymmetricDifference) {
+    auto a = make({"A", "B", "C"});
+    a.symmetric_difference(make({"E", "B", "D"}));
+    EXPECT_EQ(type_names(a), (std::vector<std::string> {"A", "C", "E", "D"}));
+    EXPECT_FALSE(a.contains(find_descendant_by_name(root, "B")));
+  }
+
+  TEST_F(FilterSetTest, OperandsWithRemovedEntries) {
+    auto a = make({"A", "B", "C"});
+    auto b = make({"B", "C", "D"});
+    b.remove(find_descendant_by_name(root, "C"));
+
+    a.unite(b);
+    EXPECT_EQ(type_names(a), (std::vector<std::string> {"A", "B", "C", "D"}));
+    a.subtract(b);
+    EXPECT_EQ(type_names(a), (std::vector<std::string> {"A", "C"}));
+  }
+
+  // ============================================================================
+  // Name Pattern Tests
+  // ============================================================================
+
+  class FilterNamePatternTest : public FilterTest {
+   protected:
+    void SetUp() override {
+      root = parse(R"(
+        namespace engine {
+          namespace components { struct Transform {}; struct Mesh {}; }
+          namespace render {
+            namespace components { struct Light {}; }
+            namespace detail { struct Cache {}; }
+          }
+          namespace detail { struct Pool {}; }
+          struct World {};
+        }
+        namespace editor { namespace components { struct Gizmo {}; } }
+      )");
+      ASSERT_NE(root, nullptr);
+    }
+
+    std::vector<std::string> select(const std::vector<std::string>& patterns,
+                                    const std::vector<std::string>& avoid = {}) {
+      xccmeta::filter::config cfg;
+      cfg.name_patterns = patterns;
+      cfg.avoid_name_patterns = avoid;
+      xccmeta::filter list(cfg);
+      list.add_tree(root);
+      return type_names(list);
+    }
+
+    xccmeta::node_ptr root;
+  };
+
+  TEST_F(FilterNamePatternTest, DoubleStarMatchesAnyNumberOfSegments) {
+    EXPECT_EQ(select({"engine::**::components::*"}), (std::vector<std::string> {"Transform", "Mesh", "Light"}));
+    EXPECT_EQ(select({"**::components::*"}), (std::vector<std::string> {"Transform", "Mesh", "Light", "Gizmo"}));
+  }
+
+  TEST_F(FilterNamePatternTest, SingleStarStaysWithinOneSegment) {
+    EXPECT_EQ(select({"engine::*"}), (std::vector<std::string> {"World"}));
+    EXPECT_EQ(select({"engine::*::M*"}), (std::vector<std::string> {"Mesh"}));
+    EXPECT_EQ(select({"engine::components::?esh"}), (std::vector<std::string> {"Mesh"}));
+    EXPECT_EQ(select({"engine::components"}), (std::vector<std::string> {}));  // Namespaces are not types
+  }
+
+  TEST_F(FilterNamePatternTest, AvoidPatternsExclude) {
+    EXPECT_EQ(select({"engine::**"}, {"**::detail::**"}),
+              (std::vector<std::string> {"Transform", "Mesh", "Light", "World"}));
+    EXPECT_EQ(select({}, {"engine::**", "*::components::Gizmo"}), (std::vector<std::string> {}));
+  }
+
+  TEST_F(FilterNamePatternTest, PatternsSharingPrefixes) {
+    EXPECT_EQ(select({"engine::render::**", "engine::render::components::*", "editor::**::Gizmo"}),
+              (std::vector<std::string> {"Light", "Cache", "Gizmo"}));
+  }
+
 }  // namespace
@@ -258,6 +258,65 @@ TEST(FileTest, PathWithSpecialCharacters) {
   EXPECT_EQ(f.read(), content);
 }
 
+// =============================================================================
+// mapped_file tests
+// =============================================================================
+
+// Test map() exposes the same bytes as read()
+TEST(MappedFileTest, MapMatchesRead) {
+  TempTestEnvironment env;
+  std::string content = "struct foo { int x; };\n";
+  content.push_back('\0');
+  content += "trailing";
+  auto file_path = env.create_file("mapped.hpp", content);
+
+  xccmeta::file f(file_path);
+  const auto mapped = f.map();
+
+  ASSERT_TRUE(mapped.is_valid());
+  EXPECT_EQ(mapped.size(), content.size());
+  EXPECT_EQ(mapped.view(), f.read());
+}
+
+// Test map() of an empty file is valid with an empty view
+TEST(MappedFileTest, EmptyFileIsValid) {
+  TempTestEnvironment env;
+  auto file_path = env.create_file("empty.hpp", "");
+
+  const auto mapped = xccmeta::file(file_path).map();
+
+  EXPECT_TRUE(mapped.is_valid());
+  EXPECT_FALSE(mapped.is_mapped());
+  EXPECT_TRUE(mapped.view().empty());
+}
+
+// Test map() of a missing file is invalid
+TEST(MappedFileTest, MissingFileIsInvalid) {
+  TempTestEnvironment env;
+
+  const auto mapped = xccmeta::file(env.get_test_dir() / "missing.hpp").map();
+
+  EXPECT_FALSE(mapped.is_valid());
+  EXPECT_TRUE(mapped.view().empty());
+}
+
+// Test moving a mapped_file keeps the view and empties the source
+TEST(MappedFileTest, MovePreservesView) {
+  TempTestEnvironment env;
+  const std::string content = "namespace ns { class bar; }\n";
+  auto file_path = env.create_file("moved.hpp", content);
+
+  auto first = xccmeta::file(file_path).map();
+  xccmeta::mapped_file second(std::move(first));
+  EXPECT_EQ(second.view(), content);
+  EXPECT_FALSE(first.is_valid());
+
+  xccmeta::mapped_file third;
+  third = std::move(second);
+  EXPECT_EQ(third.view(), content);
+  EXPECT_TRUE(second.view().empty());
+}
+
 // =============================================================================
 // importer class tests
 // =============================================================================
@@ -399,6 +458,314 @@ TEST(ImporterTest, PathWithSpaces) {
   EXPECT_EQ(imp.get_files().size(), 1);
 }
 
+// =============================================================================
+// glob tests
+// =============================================================================
+
+namespace {
+
+  std::vector<std::string> relative_names(const xccmeta::importer& imp, const std::filesystem::path& base) {
+    std::vector<std::string> names;
+    for (const auto& f : imp.get_files()) {
+      names.push_back(f.get_path().lexically_relative(base).generic_string());
+    }
+    return names;
+  }
+
+}  // namespace
+
+TEST(GlobTest, SegmentWildcards) {
+  xccmeta::glob g("src/*.h?p");
+  EXPECT_TRUE(g.matches("src/a.hpp"));
+  EXPECT_TRUE(g.matches("src/.hxp"));
+  EXPECT_FALSE(g.matches("src/a.h"));
+  EXPECT_FALSE(g.matches("src/sub/a.hpp"));
+  EXPECT_FALSE(g.matches("lib/src/a.hpp"));
+  EXPECT_EQ(g.get_base(), "src/");
+  EXPECT_FALSE(g.is_literal());
+}
+
+TEST(GlobTest, CharacterClasses) {
+  xccmeta::glob digits("file[0-9].txt");
+  EXPECT_TRUE(digits.matches("file7.txt"));
+  EXPECT_FALSE(digits.matches("fileA.txt"));
+
+  xccmeta::glob negated("file[!0-9].txt");
+  EXPECT_TRUE(negated.matches("fileA.txt"));
+  EXPECT_FALSE(negated.matches("file7.txt"));
+
+  xccmeta::glob set("[abc]_[^x].cpp");
+  EXPECT_TRUE(set.matches("b_y.cpp"));
+  EXPECT_FALSE(set.matches("d_y.cpp"));
+  EXPECT_FALSE(set.matches("a_x.cpp"));
+}
+
+TEST(GlobTest, DoubleStarSpansDirectories) {
+  xccmeta::glob g("include/**/*.hpp");
+  EXPECT_TRUE(g.matches("include/a.hpp"));
+  EXPECT_TRUE(g.matches("include/x/y/z/a.hpp"));
+  EXPECT_FALSE(g.matches("include/x/a.cpp"));
+
+  EXPECT_TRUE(g.may_match_below("include/x"));
+  EXPECT_FALSE(g.may_match_below("src"));
+
+  xccmeta::glob build("build/**");
+  EXPECT_TRUE(build.matches_all_below("build"));
+  EXPECT_TRUE(build.matches_all_below("build/debug"));
+  EXPECT_FALSE(build.matches_all_below("src"));
+  EXPECT_FALSE(g.matches_all_below("include"));
+}
+
+TEST(GlobTest, LiteralPattern) {
+  xccmeta::glob g("dir/file.txt");
+  EXPECT_TRUE(g.is_literal());
+  EXPECT_TRUE(g.matches("dir/file.txt"));
+  EXPECT_FALSE(g.matches("dir/file.txtx"));
+  EXPECT_EQ(g.get_base(), "dir/");
+}
+
+// =============================================================================
+// importer pattern tests
+// =============================================================================
+
+TEST(ImporterTest, ExtensionPattern) {
+  TempTestEnvironment env;
+  env.create_file("b.hpp");
+  env.create_file("a.hpp");
+  env.create_file("c.cpp");
+
+  xccmeta::importer imp((env.get_test_dir() / "*.hpp").string());
+  EXPECT_EQ(relative_names(imp, env.get_test_dir()), (std::vector<std::string> {"a.hpp", "b.hpp"}));
+}
+
+TEST(ImporterTest, RecursivePatternIsSorted) {
+  TempTestEnvironment env;
+  env.create_subdir("include/engine/detail");
+  env.create_subdir("include/game");
+  env.create_file("include/root.hpp");
+  env.create_file("include/engine/world.hpp");
+  env.create_file("include/engine/world.cpp");
+  env.create_file("include/engine/detail/pool.hpp");
+  env.create_file("include/game/player.hpp");
+
+  xccmeta::importer imp((env.get_test_dir() / "include/**/*.hpp").generic_string());
+  EXPECT_EQ(relative_names(imp, env.get_test_dir()),
+            (std::vector<std::string> {"include/engine/detail/pool.hpp", "include/engine/world.hpp",
+                                       "include/game/player.hpp", "include/root.hpp"}));
+}
+
+TEST(ImporterTest, MultiplePatternsWithExclusions) {
+  TempTestEnvironment env;
+  env.create_subdir("src/detail");
+  env.create_subdir("build/gen");
+  env.create_file("src/a.hpp");
+  env.create_file("src/a.cpp");
+  env.create_file("src/a_test.cpp");
+  env.create_file("src/detail/impl.hpp");
+  env.create_file("build/gen/out.hpp");
+
+  const std::string dir = env.get_test_dir().generic_string();
+  xccmeta::importer::config cfg;
+  cfg.patterns = {dir + "/**/*.hpp", dir + "/src/*.cpp", dir + "/src/a.hpp"};
+  cfg.exclude_patterns = {dir + "/**/*_test.cpp", dir + "/build/**", dir + "/**/detail/**"};
+
+  xccmeta::importer imp(cfg);
+  EXPECT_EQ(relative_names(imp, env.get_test_dir()), (std::vector<std::string> {"src/a.cpp", "src/a.hpp"}));
+}
+
+TEST(ImporterTest, ParallelWalkMatchesSerialWalk) {
+  TempTestEnvironment env;
+  for (int d = 0; d < 6; ++d) {
+    const std::string sub = "d" + std::to_string(d) + "/inner";
+    env.create_subdir(sub);
+    for (int f = 0; f < 5; ++f) {
+      env.create_file(sub + "/f" + std::to_string(f) + ".hpp");
+      env.create_file("d" + std::to_string(d) + "/g" + std::to_string(f) + ".hpp");
+    }
+  }
+
+  xccmeta::importer::config cfg;
+  cfg.patterns = {(env.get_test_dir() / "**" / "*.hpp").generic_string()};
+  xccmeta::importer serial(cfg);
+  EXPECT_EQ(serial.get_files().size(), 60);
+
+  for (unsigned threads : {2u, 4u, 0u}) {
+    cfg.thread_count = threads;
+    xccmeta::importer parallel(cfg);
+    EXPECT_EQ(relative_names(parallel, env.get_test_dir()), relative_names(serial, env.get_test_dir()));
+  }
+}
+
+// =============================================================================
+// manifest tests
+// =============================================================================
+
+namespace {
+
+  std::vector<std::string> relative_names(const std::vector<xccmeta::file>& files, const std::filesystem::path& base) {
+    std::vector<std::string> names;
+    for (const auto& f : files) {
+      names.push_back(f.get_path().lexically_relative(base).generic_string());
+    }
+    return names;
+  }
+
+}  // namespace
+
+TEST(ManifestTest, HashContent) {
+  using xccmeta::manifest;
+  EXPECT_EQ(manifest::hash_content(""), manifest::hash_content(""));
+  EXPECT_NE(manifest::hash_content(""), manifest::hash_content(std::string_view("\0", 1)));
+
+  // Flipping any single byte changes the hash, for tail, word and block lengths
+  for (std::size_t length : {1u, 7u, 8u, 31u, 32u, 100u}) {
+    std::string text(length, 'a');
+    const auto base = manifest::hash_content(text);
+    for (std::size_t i = 0; i < length; ++i) {
+      text[i] = 'b';
+      EXPECT_NE(manifest::hash_content(text), base) << "length " << length << ", byte " << i;
+      text[i] = 'a';
+    }
+    EXPECT_EQ(manifest::hash_content(text), base);
+  }
+}
+
+TEST(ManifestTest, SaveAndLoadRoundTrip) {
+  TempTestEnvironment env;
+  env.create_file("b.hpp", "struct b;");
+  env.create_file("a.hpp", "struct a;");
+  std::vector<xccmeta::file> files = {xccmeta::file(env.get_test_dir() / "b.hpp"),
+                                      xccmeta::file(env.get_test_dir() / "a.hpp"),
+                                      xccmeta::file(env.get_test_dir() / "missing.hpp")};
+
+  const auto scanned = xccmeta::manifest::scan(files);
+  ASSERT_EQ(scanned.get_entries().size(), 2);  // Missing file left out, rest sorted
+  EXPECT_EQ(scanned.get_entries()[0].file_path.filename(), "a.hpp");
+  EXPECT_EQ(scanned.get_entries()[0].size, 9);
+  EXPECT_EQ(scanned.get_entries()[0].hash, xccmeta::manifest::hash_content("struct a;"));
+
+  const auto manifest_path = env.get_test_dir() / "state.manifest";
+  ASSERT_TRUE(scanned.save(manifest_path));
+
+  xccmeta::manifest loaded;
+  ASSERT_TRUE(loaded.load(manifest_path));
+  ASSERT_EQ(loaded.get_entries().size(), 2);
+  for (std::size_t i = 0; i < 2; ++i) {
+    const auto& a = scanned.get_entries()[i];
+    const auto& b = loaded.get_entries()[i];
+    EXPECT_EQ(a.file_path, b.file_path);
+    EXPECT_EQ(a.size, b.size);
+    EXPECT_EQ(a.mtime, b.mtime);
+    EXPECT_EQ(a.inode, b.inode);
+    EXPECT_EQ(a.hash, b.hash);
+  }
+  EXPECT_NE(loaded.find(env.get_test_dir() / "b.hpp"), nullptr);
+  EXPECT_EQ(loaded.find(env.get_test_dir() / "c.hpp"), nullptr);
+  EXPECT_TRUE(loaded.diff(scanned).empty());
+}
+
+TEST(ManifestTest, LoadRejectsMalformedFiles) {
+  TempTestEnvironment env;
+  xccmeta::manifest m;
+  EXPECT_FALSE(m.load(env.get_test_dir() / "missing.manifest"));
+  EXPECT_FALSE(m.load(env.create_file("garbage.manifest", "not a manifest")));
+
+  env.create_file("a.hpp", "x");
+  const auto manifest_path = env.get_test_dir() / "truncated.manifest";
+  ASSERT_TRUE(xccmeta::manifest::scan({xccmeta::file(env.get_test_dir() / "a.hpp")}).save(manifest_path));
+  std::string data = xccmeta::file(manifest_path).read();
+  data.pop_back();
+  ASSERT_TRUE(xccmeta::file(manifest_path).write(data));
+  EXPECT_FALSE(m.load(manifest_path));
+  EXPECT_TRUE(m.get_entries().empty());
+}
+
+TEST(ManifestTest, SelectAndMerge) {
+  TempTestEnvironment env;
+  const auto dir = env.get_test_dir();
+  env.create_file("a.hpp", "struct a;");
+  env.create_file("b.hpp", "struct b;");
+  env.create_file("c.hpp", "struct c;");
+  const xccmeta::file a(dir / "a.hpp"), b(dir / "b.hpp"), c(dir / "c.hpp");
+
+  const auto all = xccmeta::manifest::scan({a, b, c});
+  auto picked = all.select({c, a, xccmeta::file(dir / "missing.hpp")});
+  ASSERT_EQ(picked.get_entries().size(), 2);
+  EXPECT_EQ(picked.get_entries()[0].file_path, a.get_path());
+  EXPECT_EQ(picked.get_entries()[1].file_path, c.get_path());
+
+  env.create_file("c.hpp", "struct c { int x; };");
+  picked.merge(xccmeta::manifest::scan({b, c}));
+  ASSERT_EQ(picked.get_entries().size(), 3);
+  EXPECT_EQ(picked.get_entries()[1].file_path, b.get_path());
+  EXPECT_EQ(picked.get_entries()[2].hash, xccmeta::manifest::hash_content("struct c { int x; };"));
+  EXPECT_EQ(picked.diff(all).changed.size(), 1);
+}
+
+TEST(ManifestTest, ImporterReportsChangesSincePreviousRun) {
+  TempTestEnvironment env;
+  const auto dir = env.get_test_dir();
+  env.create_file("a.hpp", "struct a;");
+  env.create_file("b.hpp", "struct b;");
+  env.create_file("same.hpp", "struct same;");
+
+  xccmeta::importer::config cfg;
+  cfg.patterns = {(dir / "*.hpp").generic_string()};
+  cfg.manifest_path = dir / "state.manifest";
+
+  {
+    xccmeta::importer first(cfg);
+    EXPECT_EQ(relative_names(first.get_changes().added, dir),
+              (std::vector<std::string> {"a.hpp", "b.hpp", "same.hpp"}));
+    EXPECT_TRUE(first.get_changes().changed.empty());
+    ASSERT_TRUE(first.save_manifest());
+  }
+
+  env.create_file("a.hpp", "struct a { int x; };");
+  env.create_file("same.hpp", "struct same;");  // Rewritten with identical content
+  env.create_file("c.hpp", "struct c;");
+  std::filesystem::remove(dir / "b.hpp");
+
+  xccmeta::importer second(cfg);
+  const auto& changes = second.get_changes();
+  EXPECT_EQ(relative_names(changes.changed, dir), (std::vector<std::string> {"a.hpp"}));
+  EXPECT_EQ(relative_names(changes.added, dir), (std::vector<std::string> {"c.hpp"}));
+  ASSERT_EQ(changes.removed.size(), 1);
+  EXPECT_EQ(changes.removed[0].filename(), "b.hpp");
+  EXPECT_EQ(second.get_files().size(), 3);
+
+  cfg.only_changed = true;
+  xccmeta::importer only_changed(cfg);
+  EXPECT_EQ(relative_names(only_changed, dir), (std::vector<std::string> {"a.hpp", "c.hpp"}));
+
+  // Nothing was saved since the first run, so the changes are reported again
+  EXPECT_EQ(only_changed.get_changes().removed.size(), 1);
+  ASSERT_TRUE(only_changed.save_manifest());
+  xccmeta::importer settled(cfg);
+  EXPECT_TRUE(settled.get_changes().empty());
+  EXPECT_TRUE(settled.get_files().empty());
+}
+
+TEST(ManifestTest, ParallelScanMatchesSerialScan) {
+  TempTestEnvironment env;
+  std::vector<xccmeta::file> files;
+  for (int i = 0; i < 40; ++i) {
+    const std::string name = "f" + std::to_string(i) + ".hpp";
+    env.create_file(name, std::string(static_cast<std::size_t>(i) * 13, static_cast<char>('a' + i % 26)));
+    files.emplace_back(env.get_test_dir() / name);
+  }
+
+  const auto serial = xccmeta::manifest::scan(files);
+  for (unsigned threads : {2u, 8u, 0u}) {
+    const auto parallel = xccmeta::manifest::scan(files, nullptr, threads);
+    ASSERT_EQ(parallel.get_entries().size(), serial.get_entries().size());
+    for (std::size_t i = 0; i < serial.get_entries().size(); ++i) {
+      EXPECT_EQ(parallel.get_entries()[i].file_path, serial.get_entries()[i].file_path);
+      EXPECT_EQ(parallel.get_entries()[i].hash, serial.get_entries()[i].hash);
+    }
+  }
+}
+
 // =============================================================================
 // Integration tests
 // =============================================================================
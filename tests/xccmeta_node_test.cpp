@@ -469,4 +469,224 @@ namespace {
     EXPECT_EQ(child, my_struct->get_children().front());
   }
 
+  // ============================================================================
+  // Interned tag id tests
+  // ============================================================================
+
+  TEST_F(NodeTagTest, HasTagById) {
+    auto root = parse(R"(
+      /// @reflect
+      /// @serialize(binary)
+      struct Tagged { int x; };
+    )");
+    ASSERT_NE(root, nullptr);
+
+    auto tagged = find_descendant_by_name(root, "Tagged");
+    ASSERT_NE(tagged, nullptr);
+
+    auto reflect_id = xccmeta::tag::lookup("reflect");
+    auto serialize_id = xccmeta::tag::lookup("serialize");
+    ASSERT_NE(reflect_id, xccmeta::tag::invalid_id);
+    ASSERT_NE(serialize_id, xccmeta::tag::invalid_id);
+
+    EXPECT_TRUE(tagged->has_tag(reflect_id));
+    EXPECT_TRUE(tagged->has_tag_ids({xccmeta::tag::intern("xccmeta::unused_tag"), serialize_id}));
+    EXPECT_FALSE(tagged->has_tag(xccmeta::tag::intern("xccmeta::unused_tag")));
+    EXPECT_FALSE(tagged->has_tag(xccmeta::tag::invalid_id));
+    EXPECT_NE(tagged->get_tag_mask() & xccmeta::tag::mask_of(reflect_id), 0u);
+
+    auto found = tagged->find_tag(serialize_id);
+    ASSERT_TRUE(found.has_value());
+    ASSERT_EQ(found->get_args().size(), 1);
+    EXPECT_EQ(found->get_args()[0], "binary");
+  }
+
+  TEST_F(NodeTagTest, UnknownTagNameIsNeverPresent) {
+    auto root = parse(R"(
+      /// @reflect
+      struct Tagged { int x; };
+    )");
+    ASSERT_NE(root, nullptr);
+
+    auto tagged = find_descendant_by_name(root, "Tagged");
+    ASSERT_NE(tagged, nullptr);
+
+    EXPECT_FALSE(tagged->has_tag("xccmeta::name_nobody_interned"));
+    EXPECT_FALSE(tagged->find_tag("xccmeta::name_nobody_interned").has_value());
+    EXPECT_EQ(tagged->find_tags({"xccmeta::name_nobody_interned", "reflect"}).size(), 1);
+  }
+
+  // ============================================================================
+  // Inherited tag view tests
+  // ============================================================================
+
+  TEST_F(NodeTagTest, ParentTagsViewMatchesCopy) {
+    auto root = parse(R"(
+      /// @module(core)
+      namespace core {
+        /// @reflect
+        struct Widget {
+          /// @serialize
+          int id;
+        };
+      }
+    )");
+    ASSERT_NE(root, nullptr);
+
+    auto field = find_descendant_by_name(root, "id");
+    ASSERT_NE(field, nullptr);
+
+    auto view = field->get_parent_tags_view();
+    auto copy = field->get_parent_tags();
+    ASSERT_EQ(view.size(), copy.size());
+    ASSERT_EQ(view.size(), 2);
+    EXPECT_EQ(view[0].get_name(), "reflect");
+    EXPECT_EQ(view[1].get_name(), "module");
+
+    auto all = field->get_all_tags_view();
+    ASSERT_EQ(all.size(), 3);
+    EXPECT_EQ(all[0].get_name(), "serialize");
+    EXPECT_EQ(all[2].get_name(), "module");
+  }
+
+  TEST_F(NodeTagTest, SiblingsShareInheritedTags) {
+    auto root = parse(R"(
+      /// @reflect
+      struct Widget {
+        int a;
+        int b;
+      };
+    )");
+    ASSERT_NE(root, nullptr);
+
+    auto a = find_descendant_by_name(root, "a");
+    auto b = find_descendant_by_name(root, "b");
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+
+    auto view_a = a->get_parent_tags_view();
+    auto view_b = b->get_parent_tags_view();
+    ASSERT_EQ(view_a.size(), 1);
+    EXPECT_EQ(view_a.data(), view_b.data());
+
+    // Untagged nodes reuse the inherited list for their "all tags" view
+    EXPECT_EQ(a->get_all_tags_view().data(), view_a.data());
+  }
+
+  // ============================================================================
+  // Typed child view tests
+  // ============================================================================
+
+  TEST_F(NodeTagTest, TypedChildViewsGroupByKind) {
+    auto root = parse(R"(
+      struct Base {};
+      struct Widget : Base {
+        int a;
+        Widget();
+        void draw();
+        int b;
+        ~Widget();
+        operator bool() const;
+        float c;
+      };
+    )");
+    ASSERT_NE(root, nullptr);
+
+    auto widget = find_descendant_by_name(root, "Widget");
+    ASSERT_NE(widget, nullptr);
+
+    auto fields = widget->get_fields();
+    ASSERT_EQ(fields.size(), 3);
+    EXPECT_EQ(fields[0]->get_name(), "a");
+    EXPECT_EQ(fields[1]->get_name(), "b");
+    EXPECT_EQ(fields[2]->get_name(), "c");
+
+    // Constructors, destructors and conversions stay in source order with methods
+    auto methods = widget->get_methods();
+    ASSERT_EQ(methods.size(), 4);
+    EXPECT_EQ(methods[0]->get_kind(), xccmeta::node::kind::constructor_decl);
+    EXPECT_EQ(methods[1]->get_kind(), xccmeta::node::kind::method_decl);
+    EXPECT_EQ(methods[2]->get_kind(), xccmeta::node::kind::destructor_decl);
+    EXPECT_EQ(methods[3]->get_kind(), xccmeta::node::kind::conversion_decl);
+
+    EXPECT_EQ(widget->get_bases().size(), 1);
+    EXPECT_TRUE(widget->get_parameters().empty());
+    EXPECT_EQ(widget->get_children_by_kind(xccmeta::node::kind::destructor_decl).size(), 1);
+  }
+
+  TEST_F(NodeTagTest, TypedChildViewsDoNotCopy) {
+    auto root = parse(R"(
+      struct Widget { int a; int b; };
+    )");
+    ASSERT_NE(root, nullptr);
+
+    auto widget = find_descendant_by_name(root, "Widget");
+    ASSERT_NE(widget, nullptr);
+
+    auto first = widget->get_fields();
+    auto second = widget->get_fields();
+    EXPECT_EQ(first.data(), second.data());
+    EXPECT_EQ(first[0], widget->get_children()[0]);
+  }
+
+  // ============================================================================
+  // Structural hash tests
+  // ============================================================================
+
+  TEST_F(NodeTagTest, HashIsStableAcrossParses) {
+    const char* code = R"(
+      /// @reflect
+      struct Player { int health; float speed; void update(); };
+    )";
+    auto first = parse(code);
+    auto second = parse(code);
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+
+    EXPECT_NE(first->get_hash(), 0u);
+    EXPECT_EQ(first->get_hash(), second->get_hash());
+    EXPECT_EQ(first->get_hash_with_locations(), second->get_hash_with_locations());
+  }
+
+  TEST_F(NodeTagTest, HashIgnoresPositionsUnlessRequested) {
+    auto original = parse("struct Point { int x; int y; };");
+    auto shifted = parse("\n\n   struct Point { int x; int y; };");
+    auto a = find_descendant_by_name(original, "Point");
+    auto b = find_descendant_by_name(shifted, "Point");
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+
+    EXPECT_EQ(a->get_hash(), b->get_hash());
+    EXPECT_NE(a->get_hash_with_locations(), b->get_hash_with_locations());
+  }
+
+  TEST_F(NodeTagTest, HashCoversChildrenAndAttributes) {
+    auto base = find_descendant_by_name(parse("struct S { int x; int y; };"), "S");
+    auto renamed_field = find_descendant_by_name(parse("struct S { int x; int z; };"), "S");
+    auto retyped_field = find_descendant_by_name(parse("struct S { int x; long y; };"), "S");
+    auto reordered = find_descendant_by_name(parse("struct S { int y; int x; };"), "S");
+    auto tagged = find_descendant_by_name(parse("/// @reflect\nstruct S { int x; int y; };"), "S");
+    ASSERT_NE(base, nullptr);
+
+    for (const auto& other : {renamed_field, retyped_field, reordered, tagged}) {
+      ASSERT_NE(other, nullptr);
+      EXPECT_NE(base->get_hash(), other->get_hash());
+    }
+
+    // Unchanged children keep their hash
+    EXPECT_EQ(base->get_children()[0]->get_hash(), renamed_field->get_children()[0]->get_hash());
+  }
+
+  TEST_F(NodeTagTest, IdenticalSubtreesShareHash) {
+    auto first = parse("struct Vec { float x, y; }; struct A {};");
+    auto second = parse("struct B {}; struct Vec { float x, y; };");
+    auto a = find_descendant_by_name(first, "Vec");
+    auto b = find_descendant_by_name(second, "Vec");
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+
+    EXPECT_EQ(a->get_hash(), b->get_hash());
+    EXPECT_NE(first->get_hash(), second->get_hash());
+  }
+
 }  // namespace
@@ -27,6 +27,7 @@ SOFTWARE.
 
 #include <algorithm>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace {
@@ -1122,6 +1123,157 @@ namespace {
     EXPECT_EQ(method->get_access(), xccmeta::access_specifier::public_);
   }
 
+  TEST(ParserTest, MergeAllMatchesPairwiseMerge) {
+    xccmeta::parser p;
+    xccmeta::compile_args args = xccmeta::compile_args::modern_cxx();
+    const std::vector<std::string> sources = {
+        "struct Shared { int a; }; void f();",
+        "struct Shared { int a; }; struct Item { Shared s; };",
+        "namespace ns { struct Inner {}; } struct Item { Shared s; }; int g;",
+        "void f(); enum Color { Red };",
+    };
+
+    xccmeta::node_ptr folded;
+    std::vector<xccmeta::node_ptr> roots;
+    for (const auto& source : sources) {
+      folded = folded ? p.merge(folded, p.parse(source, args), args) : p.parse(source, args);
+      roots.push_back(p.parse(source, args));
+    }
+    std::vector<xccmeta::node_ptr> inputs = roots;
+    inputs.insert(inputs.begin() + 1, nullptr);
+
+    auto merged = p.merge_all(inputs, args);
+    ASSERT_NE(merged, nullptr);
+    EXPECT_EQ(merged->get_kind(), xccmeta::node::kind::translation_unit);
+    EXPECT_EQ(merged->get_children().size(), folded->get_children().size());
+    EXPECT_EQ(merged->get_hash(), folded->get_hash());
+
+    // Subtrees were moved, not copied
+    for (const auto& root : roots) EXPECT_TRUE(root->get_children().empty());
+    for (const auto& child : merged->get_children()) EXPECT_EQ(child->get_parent(), merged);
+  }
+
+  TEST(ParserTest, MergeAllLinksTypesAcrossInputs) {
+    xccmeta::parser p;
+    xccmeta::compile_args args = xccmeta::compile_args::modern_cxx();
+
+    auto merged = p.merge_all({p.parse("struct Item { int id; };", args),
+                               p.parse("struct Item; struct Holder { Item* item; };", args)},
+                              args);
+    ASSERT_NE(merged, nullptr);
+
+    auto item = find_descendant_by_name(find_descendant_by_name(merged, "Holder"), "item");
+    ASSERT_NE(item, nullptr);
+    auto decl = item->get_type_declaration();
+    ASSERT_NE(decl, nullptr);
+    EXPECT_TRUE(decl->is_definition());
+  }
+
+  TEST(ParserTest, MergeAllEmptyInput) {
+    xccmeta::parser p;
+    xccmeta::compile_args args;
+    auto merged = p.merge_all({}, args);
+    ASSERT_NE(merged, nullptr);
+    EXPECT_TRUE(merged->get_children().empty());
+  }
+
+  TEST(ParserTest, MergeUnifiesReopenedNamespaces) {
+    xccmeta::parser p;
+    xccmeta::compile_args args = xccmeta::compile_args::modern_cxx();
+
+    auto a = p.parse("namespace engine { struct A {}; namespace detail { struct X {}; } }", args);
+    auto b = p.parse("namespace engine { struct B {}; namespace detail { struct X {}; struct Y {}; } }", args);
+    auto merged = p.merge(a, b, args);
+    ASSERT_NE(merged, nullptr);
+
+    ASSERT_EQ(merged->get_children().size(), 1);
+    auto engine = merged->get_children()[0];
+    EXPECT_EQ(engine->get_name(), "engine");
+
+    std::vector<std::string> names;
+    for (const auto& child : engine->get_children()) names.push_back(child->get_name());
+    EXPECT_EQ(names, (std::vector<std::string> {"A", "detail", "B"}));
+
+    auto detail = find_descendant_by_name(engine, "detail");
+    ASSERT_NE(detail, nullptr);
+    ASSERT_EQ(detail->get_children().size(), 2);
+    EXPECT_EQ(detail->get_children()[1]->get_name(), "Y");
+    EXPECT_EQ(detail->get_children()[1]->get_parent(), detail);
+
+    // Inputs are left untouched
+    EXPECT_EQ(b->get_children()[0]->get_children().size(), 2);
+  }
+
+  TEST(ParserTest, MergePrefersDefinitions) {
+    xccmeta::parser p;
+    xccmeta::compile_args args = xccmeta::compile_args::modern_cxx();
+
+    auto a = p.parse("namespace ns { struct Item; struct First {}; } extern int counter;", args);
+    auto b = p.parse("namespace ns { struct Item { int id; }; } int counter = 0;", args);
+    auto merged = p.merge(a, b, args);
+    ASSERT_NE(merged, nullptr);
+
+    ASSERT_EQ(merged->get_children().size(), 2);
+    auto ns = merged->get_children()[0];
+    ASSERT_EQ(ns->get_children().size(), 2);
+    auto item = ns->get_children()[0];  // Keeps the position of the forward declaration
+    EXPECT_EQ(item->get_name(), "Item");
+    EXPECT_TRUE(item->is_definition());
+    EXPECT_EQ(item->get_fields().size(), 1);
+    EXPECT_TRUE(merged->get_children()[1]->is_definition());
+
+    // A later forward declaration does not replace a definition
+    auto again = p.merge(merged, p.parse("namespace ns { struct Item; }", args), args);
+    EXPECT_TRUE(again->get_children()[0]->get_children()[0]->is_definition());
+  }
+
+  TEST(ParserTest, MergeUnifiesLinkageSpecs) {
+    xccmeta::parser p;
+    xccmeta::compile_args args = xccmeta::compile_args::modern_cxx();
+
+    auto merged = p.merge_all({p.parse(R"(extern "C" { void c_a(); })", args),
+                               p.parse(R"(extern "C" { void c_a(); void c_b(); })", args)},
+                              args);
+    ASSERT_NE(merged, nullptr);
+    ASSERT_EQ(merged->get_children().size(), 1);
+    EXPECT_EQ(merged->get_children()[0]->get_kind(), xccmeta::node::kind::linkage_spec);
+    EXPECT_EQ(merged->get_children()[0]->get_children().size(), 2);
+  }
+
+  TEST(ParserTest, MergeAllIsDeterministicAcrossThreadCounts) {
+    xccmeta::parser p;
+    xccmeta::compile_args args = xccmeta::compile_args::modern_cxx();
+
+    std::vector<std::string> sources;
+    for (int i = 0; i < 24; ++i) {
+      const std::string n = std::to_string(i);
+      const std::string shared = i % 3 == 0 ? "struct Shared { int v; };" : "struct Shared;";
+      sources.push_back("namespace app { " + shared + " struct T" + n + " { Shared* s; }; }" +
+                        " namespace app::m" + std::to_string(i % 4) + " { struct U" + n + " {}; }" +
+                        R"( extern "C" { void c)" + n + "(); }");
+    }
+    auto parse_all = [&] {
+      std::vector<xccmeta::node_ptr> roots;
+      for (const auto& source : sources) roots.push_back(p.parse(source, args));
+      return roots;
+    };
+
+    auto serial = p.merge_all(parse_all(), args, 1);
+    ASSERT_NE(serial, nullptr);
+    ASSERT_EQ(serial->get_children().size(), 2);  // app, extern "C"
+
+    for (unsigned threads : {2u, 3u, 5u, 0u}) {
+      auto parallel = p.merge_all(parse_all(), args, threads);
+      ASSERT_NE(parallel, nullptr);
+      EXPECT_EQ(parallel->get_hash_with_locations(), serial->get_hash_with_locations()) << threads;
+    }
+
+    auto field = find_descendant_by_name(find_descendant_by_name(serial, "T5"), "s");
+    ASSERT_NE(field, nullptr);
+    ASSERT_NE(field->get_type_declaration(), nullptr);
+    EXPECT_TRUE(field->get_type_declaration()->is_definition());
+  }
+
   // ============================================================================
   // Compile Args Tests
   // ============================================================================
@@ -2269,4 +2421,141 @@ namespace {
     EXPECT_TRUE(widget->has_tag("interface"));
   }
 
+  // ============================================================================
+  // Type Reference Tests
+  // ============================================================================
+
+  TEST(ParserTest, TypeDeclarationLinksFieldToStruct) {
+    xccmeta::parser p;
+    xccmeta::compile_args args = xccmeta::compile_args::modern_cxx();
+    auto root = p.parse(R"(
+      struct Vec3 { float x, y, z; };
+      struct Transform {
+        Vec3 position;
+        const Vec3* target;
+        Vec3 path[4];
+        Vec3& anchor;
+        int id;
+      };
+    )",
+                        args);
+
+    auto vec3 = find_descendant_by_name(root, "Vec3");
+    auto transform = find_descendant_by_name(root, "Transform");
+    ASSERT_NE(vec3, nullptr);
+    ASSERT_NE(transform, nullptr);
+
+    for (const char* name : {"position", "target", "path", "anchor"}) {
+      auto field = find_child_by_name(transform, name);
+      ASSERT_NE(field, nullptr) << name;
+      EXPECT_EQ(field->get_type().get_declaration_usr(), vec3->get_usr()) << name;
+      EXPECT_EQ(field->get_type_declaration(), vec3) << name;
+    }
+
+    auto id = find_child_by_name(transform, "id");
+    ASSERT_NE(id, nullptr);
+    EXPECT_TRUE(id->get_type().get_declaration_usr().empty());
+    EXPECT_EQ(id->get_type_declaration(), nullptr);
+  }
+
+  TEST(ParserTest, TypeDeclarationResolvesTypedefs) {
+    xccmeta::parser p;
+    xccmeta::compile_args args = xccmeta::compile_args::modern_cxx();
+    auto root = p.parse(R"(
+      struct Color { unsigned char r, g, b; };
+      typedef Color Tint;
+      using Palette = Tint;
+      struct Sprite { Palette* colors; };
+    )",
+                        args);
+
+    auto color = find_descendant_by_name(root, "Color");
+    auto tint = find_descendant_by_name(root, "Tint");
+    auto palette = find_descendant_by_name(root, "Palette");
+    auto colors = find_descendant_by_name(find_descendant_by_name(root, "Sprite"), "colors");
+    ASSERT_NE(colors, nullptr);
+
+    EXPECT_EQ(colors->get_type_declaration(), color);
+    const auto& refs = colors->get_type().get_referenced_usrs();
+    ASSERT_EQ(refs.size(), 3u);
+    EXPECT_EQ(refs[0], palette->get_usr());
+    EXPECT_EQ(refs[1], tint->get_usr());
+    EXPECT_EQ(refs[2], color->get_usr());
+  }
+
+  TEST(ParserTest, TypeDeclarationThroughTemplateArguments) {
+    xccmeta::parser p;
+    xccmeta::compile_args args = xccmeta::compile_args::modern_cxx();
+    auto root = p.parse(R"(
+      template <typename T> struct Box { T value; };
+      struct Item { int id; };
+      struct Inventory { Box<Item> slot; };
+    )",
+                        args);
+
+    auto box = find_descendant_by_name(root, "Box");
+    auto item = find_descendant_by_name(root, "Item");
+    auto slot = find_descendant_by_name(find_descendant_by_name(root, "Inventory"), "slot");
+    ASSERT_NE(slot, nullptr);
+    ASSERT_EQ(box->get_kind(), xccmeta::node::kind::class_template);
+
+    // Implicit instantiations resolve to their class template
+    EXPECT_EQ(slot->get_type_declaration(), box);
+
+    const auto& refs = slot->get_type().get_referenced_usrs();
+    EXPECT_NE(std::find(refs.begin(), refs.end(), box->get_usr()), refs.end());
+    EXPECT_NE(std::find(refs.begin(), refs.end(), item->get_usr()), refs.end());
+  }
+
+  TEST(ParserTest, TypeDeclarationPrefersDefinition) {
+    xccmeta::parser p;
+    xccmeta::compile_args args = xccmeta::compile_args::modern_cxx();
+    auto root = p.parse(R"(
+      struct Node;
+      struct List { Node* head; };
+      struct Node { int value; Node* next; };
+      Node* make_node(const List& list);
+    )",
+                        args);
+
+    auto head = find_descendant_by_name(find_descendant_by_name(root, "List"), "head");
+    ASSERT_NE(head, nullptr);
+    auto decl = head->get_type_declaration();
+    ASSERT_NE(decl, nullptr);
+    EXPECT_EQ(decl->get_name(), "Node");
+    EXPECT_TRUE(decl->is_definition());
+
+    auto make_node = find_descendant_by_name(root, "make_node");
+    ASSERT_NE(make_node, nullptr);
+    EXPECT_EQ(make_node->get_return_type_declaration(), decl);
+    ASSERT_EQ(make_node->get_parameters().size(), 1u);
+    EXPECT_EQ(make_node->get_parameters()[0]->get_type_declaration()->get_name(), "List");
+  }
+
+  TEST(ParserTest, TypeDeclarationLinksSurviveMerge) {
+    xccmeta::parser p;
+    xccmeta::compile_args args = xccmeta::compile_args::modern_cxx();
+    auto tu1 = p.parse("struct A { int x; };", args);
+    auto tu2 = p.parse("struct A; struct B { A* a; };", args);
+
+    auto merged = p.merge(tu1, tu2, args);
+    auto a = find_child_by_name(merged, "A");
+    auto field = find_descendant_by_name(find_child_by_name(merged, "B"), "a");
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(field, nullptr);
+    EXPECT_EQ(field->get_type_declaration(), a);
+  }
+
+  TEST(ParserTest, ParseStringViewWithoutTerminator) {
+    // Only the first declaration is in view; the rest of the buffer must not leak into the parse
+    const std::string buffer = "int first_var;int second_var;";
+    const std::string_view input(buffer.data(), buffer.find(';') + 1);
+
+    xccmeta::parser p;
+    auto root = p.parse(input, xccmeta::compile_args::modern_cxx());
+    ASSERT_NE(root, nullptr);
+    EXPECT_NE(find_child_by_name(root, "first_var"), nullptr);
+    EXPECT_EQ(find_child_by_name(root, "second_var"), nullptr);
+  }
+
 }  // namespace
@@ -0,0 +1,203 @@
+/*
+MIT License
+
+Copyright (c) 2026 Christian Luppi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <xccmeta/xccmeta_parser.hpp>
+#include <xccmeta/xccmeta_pipeline.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+  // Unique temporary directory, removed with its contents on destruction
+  class TempDirectory {
+   public:
+    TempDirectory() {
+      static std::atomic<int> counter {0};
+      dir = std::filesystem::temp_directory_path() /
+            ("xccmeta_pipeline_test_" + std::to_string(counter.fetch_add(1)) + "_" +
+             std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+      std::filesystem::create_directories(dir);
+    }
+
+    ~TempDirectory() {
+      std::error_code ec;
+      std::filesystem::remove_all(dir, ec);
+    }
+
+    xccmeta::file create(const std::string& name, const std::string& content) const {
+      std::ofstream(dir / name, std::ios::binary) << content;
+      return xccmeta::file(dir / name);
+    }
+
+    const std::filesystem::path& path() const { return dir; }
+
+   private:
+    std::filesystem::path dir;
+  };
+
+  // One header per index, declaring struct s<index> with a padding comment so
+  // files differ in size
+  std::vector<xccmeta::file> create_headers(const TempDirectory& tmp, int count) {
+    std::vector<xccmeta::file> files;
+    for (int i = 0; i < count; ++i) {
+      const std::string name = "s" + std::to_string(i);
+      files.push_back(tmp.create(name + ".hpp", "// " + std::string(static_cast<std::size_t>(i) * 100, '-') +
+                                                    "\nstruct " + name + " { int value; };\n"));
+    }
+    return files;
+  }
+
+  std::size_t count_named(const xccmeta::node_ptr& root, const std::string& name) {
+    return root->find_descendants([&](const xccmeta::node_ptr& n) { return n->get_name() == name; }).size();
+  }
+
+  // ============================================================================
+  // Ordering and Results
+  // ============================================================================
+
+  TEST(ParsePipelineTest, EmptyInput) {
+    xccmeta::parse_pipeline pipeline;
+    EXPECT_TRUE(pipeline.run({}, xccmeta::compile_args::modern_cxx()).empty());
+  }
+
+  TEST(ParsePipelineTest, RootsFollowInputOrder) {
+    TempDirectory tmp;
+    const auto files = create_headers(tmp, 12);
+    const auto args = xccmeta::compile_args::modern_cxx();
+
+    xccmeta::parse_pipeline::config cfg;
+    cfg.read_threads = 3;
+    cfg.parse_threads = 4;
+    cfg.queue_depth = 2;
+    const auto roots = xccmeta::parse_pipeline(cfg).run(files, args);
+
+    ASSERT_EQ(roots.size(), files.size());
+    for (std::size_t i = 0; i < roots.size(); ++i) {
+      ASSERT_NE(roots[i], nullptr);
+      EXPECT_EQ(count_named(roots[i], "s" + std::to_string(i)), 1) << "file " << i;
+      EXPECT_EQ(roots[i]->get_children().size(), 1);
+    }
+  }
+
+  TEST(ParsePipelineTest, MatchesSequentialParse) {
+    TempDirectory tmp;
+    const auto files = create_headers(tmp, 6);
+    const auto args = xccmeta::compile_args::modern_cxx();
+
+    xccmeta::parser p;
+    for (const auto& [reads, parses, depth] : {std::tuple {1u, 1u, 1u}, std::tuple {4u, 2u, 3u}, std::tuple {0u, 0u, 8u}}) {
+      xccmeta::parse_pipeline::config cfg;
+      cfg.read_threads = reads;
+      cfg.parse_threads = parses;
+      cfg.queue_depth = depth;
+      const auto roots = xccmeta::parse_pipeline(cfg).run(files, args);
+      for (std::size_t i = 0; i < files.size(); ++i) {
+        EXPECT_EQ(roots[i]->get_hash(), p.parse(files[i].read(), args)->get_hash()) << "file " << i;
+      }
+    }
+  }
+
+  TEST(ParsePipelineTest, UnreadableFileGivesNullRoot) {
+    TempDirectory tmp;
+    std::vector<xccmeta::file> files = {tmp.create("a.hpp", "struct a {};"), xccmeta::file(tmp.path() / "missing.hpp"),
+                                        tmp.create("b.hpp", "struct b {};")};
+
+    const auto roots = xccmeta::parse_pipeline().run(files, xccmeta::compile_args::modern_cxx());
+    ASSERT_EQ(roots.size(), 3);
+    EXPECT_NE(roots[0], nullptr);
+    EXPECT_EQ(roots[1], nullptr);
+    EXPECT_NE(roots[2], nullptr);
+  }
+
+  // ============================================================================
+  // Backpressure and Streaming
+  // ============================================================================
+
+  TEST(ParsePipelineTest, ByteCapSmallerThanAnyFileStillCompletes) {
+    TempDirectory tmp;
+    const auto files = create_headers(tmp, 8);
+
+    xccmeta::parse_pipeline::config cfg;
+    cfg.read_threads = 4;
+    cfg.queue_bytes = 1;  // Every file exceeds the cap, so they pass one at a time
+    const auto roots = xccmeta::parse_pipeline(cfg).run(files, xccmeta::compile_args::modern_cxx());
+
+    for (std::size_t i = 0; i < files.size(); ++i) {
+      ASSERT_NE(roots[i], nullptr);
+      EXPECT_EQ(count_named(roots[i], "s" + std::to_string(i)), 1);
+    }
+  }
+
+  TEST(ParsePipelineTest, CallbackSeesEveryFileOnce) {
+    TempDirectory tmp;
+    const auto files = create_headers(tmp, 10);
+
+    xccmeta::parse_pipeline::config cfg;
+    cfg.parse_threads = 3;
+    std::mutex mutex;
+    std::vector<int> seen(files.size(), 0);
+    xccmeta::parse_pipeline(cfg).run(files, xccmeta::compile_args::modern_cxx(),
+                                     [&](std::size_t index, const xccmeta::file& source, xccmeta::node_ptr root) {
+                                       std::lock_guard lock(mutex);
+                                       seen[index]++;
+                                       EXPECT_EQ(source.get_path(), files[index].get_path());
+                                       EXPECT_NE(root, nullptr);
+                                     });
+
+    EXPECT_EQ(seen, std::vector<int>(files.size(), 1));
+  }
+
+  TEST(ParsePipelineTest, SharedRegistrySkipsRepeatedDeclarations) {
+    TempDirectory tmp;
+    std::vector<xccmeta::file> files;
+    for (int i = 0; i < 4; ++i) {
+      files.push_back(tmp.create("tu" + std::to_string(i) + ".cpp",
+                                 "struct shared { int x; };\nstruct own" + std::to_string(i) + " {};\n"));
+    }
+
+    xccmeta::usr_registry registry;
+    xccmeta::parse_pipeline::config cfg;
+    cfg.parse_threads = 2;
+    cfg.registry = &registry;
+    const auto args = xccmeta::compile_args::modern_cxx();
+    auto roots = xccmeta::parse_pipeline(cfg).run(files, args);
+
+    std::size_t shared_count = 0;
+    for (const auto& root : roots) shared_count += count_named(root, "shared");
+    EXPECT_EQ(shared_count, 1);
+
+    auto merged = xccmeta::parser {}.merge_all(std::move(roots), args);
+    EXPECT_EQ(count_named(merged, "shared"), 1);
+    EXPECT_EQ(count_named(merged, "own3"), 1);
+  }
+
+}  // namespace
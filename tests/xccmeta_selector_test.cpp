@@ -0,0 +1,181 @@
+/*
+MIT License
+
+Copyright (c) 2026 Christian Luppi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <xccmeta/xccmeta_parser.hpp>
+#include <xccmeta/xccmeta_selector.hpp>
+
+#include <string>
+#include <vector>
+
+namespace {
+
+  // ============================================================================
+  // Test Fixture - parses a small tagged corpus
+  // ============================================================================
+
+  class SelectorTest : public ::testing::Test {
+   protected:
+    xccmeta::parser p;
+    xccmeta::compile_args args = xccmeta::compile_args::modern_cxx();
+    xccmeta::node_ptr root;
+
+    void SetUp() override {
+      root = p.parse(R"(
+        namespace game {
+          /// @reflect
+          struct Player {
+            int health;
+            /// @skip
+            int cache;
+            void update();
+          };
+
+          struct Hidden {
+            int secret;
+          };
+
+          namespace detail {
+            /// @reflect
+            struct Inner {
+              float value;
+            };
+          }
+        }
+
+        namespace editor {
+          /// @reflect
+          struct Gizmo {
+            int handle;
+          };
+        }
+      )",
+                     args);
+    }
+
+    static std::vector<std::string> names(const std::vector<xccmeta::node_ptr>& nodes) {
+      std::vector<std::string> result;
+      for (const auto& n : nodes) result.push_back(n->get_name());
+      return result;
+    }
+  };
+
+  // ============================================================================
+  // Compilation
+  // ============================================================================
+
+  TEST_F(SelectorTest, CompilesValidSelector) {
+    xccmeta::selector sel("namespace[name=game] > struct_decl[@reflect] > field_decl:not([@skip])");
+    EXPECT_TRUE(sel.is_valid());
+    EXPECT_TRUE(sel.get_error().empty());
+  }
+
+  TEST_F(SelectorTest, ReportsErrors) {
+    EXPECT_FALSE(xccmeta::selector("").is_valid());
+    EXPECT_FALSE(xccmeta::selector("not_a_kind").is_valid());
+    EXPECT_FALSE(xccmeta::selector("struct[name").is_valid());
+    EXPECT_FALSE(xccmeta::selector("struct:unknown_flag").is_valid());
+    EXPECT_FALSE(xccmeta::selector("struct[bogus=1]").is_valid());
+
+    xccmeta::selector bad("struct >");
+    EXPECT_FALSE(bad.is_valid());
+    EXPECT_FALSE(bad.get_error().empty());
+    EXPECT_TRUE(bad.select(root).to_vector().empty());
+  }
+
+  // ============================================================================
+  // Selection
+  // ============================================================================
+
+  TEST_F(SelectorTest, SelectsByKindAndTag) {
+    xccmeta::selector sel("struct[@reflect]");
+    EXPECT_EQ(names(sel.select(root).to_vector()), (std::vector<std::string> {"Player", "Inner", "Gizmo"}));
+  }
+
+  TEST_F(SelectorTest, ChildCombinator) {
+    xccmeta::selector sel("namespace[name=game] > struct_decl[@reflect] > field_decl:not([@skip])");
+    EXPECT_EQ(names(sel.select(root).to_vector()), (std::vector<std::string> {"health"}));
+  }
+
+  TEST_F(SelectorTest, DescendantCombinator) {
+    xccmeta::selector sel("namespace[name=game] struct[@reflect]");
+    EXPECT_EQ(names(sel.select(root).to_vector()), (std::vector<std::string> {"Player", "Inner"}));
+  }
+
+  TEST_F(SelectorTest, AttributeOperators) {
+    EXPECT_EQ(names(xccmeta::selector("struct[qualified_name^=game::]").select(root).to_vector()),
+              (std::vector<std::string> {"Player", "Hidden", "Inner"}));
+    EXPECT_EQ(names(xccmeta::selector("struct[name$=er]").select(root).to_vector()),
+              (std::vector<std::string> {"Player", "Inner"}));
+    EXPECT_EQ(names(xccmeta::selector("field[type='float']").select(root).to_vector()),
+              (std::vector<std::string> {"value"}));
+    EXPECT_EQ(names(xccmeta::selector("namespace[name!=game]").select(root).to_vector()),
+              (std::vector<std::string> {"detail", "editor"}));
+  }
+
+  TEST_F(SelectorTest, SelectorListAndWildcard) {
+    xccmeta::selector sel("method, struct[name=Hidden] > *");
+    EXPECT_EQ(names(sel.select(root).to_vector()), (std::vector<std::string> {"update", "secret"}));
+  }
+
+  TEST_F(SelectorTest, FlagPseudoClass) {
+    xccmeta::selector sel("struct:definition:not([@reflect])");
+    EXPECT_EQ(names(sel.select(root).to_vector()), (std::vector<std::string> {"Hidden"}));
+  }
+
+  TEST_F(SelectorTest, LazyIterationStopsEarly) {
+    xccmeta::selector sel("field");
+    auto selection = sel.select(root);
+    auto it = selection.begin();
+    ASSERT_NE(it, selection.end());
+    EXPECT_EQ((*it)->get_name(), "health");
+    ++it;
+    ASSERT_NE(it, selection.end());
+    EXPECT_EQ((*it)->get_name(), "cache");
+  }
+
+  TEST_F(SelectorTest, MatchesSingleNode) {
+    xccmeta::selector sel("namespace > struct[@reflect]");
+    auto player = xccmeta::selector("struct[name=Player]").select(root).to_vector();
+    auto hidden = xccmeta::selector("struct[name=Hidden]").select(root).to_vector();
+    ASSERT_EQ(player.size(), 1);
+    ASSERT_EQ(hidden.size(), 1);
+    EXPECT_TRUE(sel.matches(player[0]));
+    EXPECT_FALSE(sel.matches(hidden[0]));
+  }
+
+  TEST_F(SelectorTest, SelectManyInOneTraversal) {
+    std::vector<xccmeta::selector> selectors = {
+        xccmeta::selector("struct[@reflect]"),
+        xccmeta::selector("field:not([@skip])"),
+        xccmeta::selector("namespace"),
+    };
+    auto results = xccmeta::selector::select_many(root, selectors);
+    ASSERT_EQ(results.size(), 3);
+    EXPECT_EQ(names(results[0]), (std::vector<std::string> {"Player", "Inner", "Gizmo"}));
+    EXPECT_EQ(names(results[1]), (std::vector<std::string> {"health", "secret", "value", "handle"}));
+    EXPECT_EQ(names(results[2]), (std::vector<std::string> {"game", "detail", "editor"}));
+  }
+
+}  // namespace
@@ -0,0 +1,193 @@
+/*
+MIT License
+
+Copyright (c) 2026 Christian Luppi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <xccmeta/xccmeta_parser.hpp>
+#include <xccmeta/xccmeta_snapshot.hpp>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+  // ============================================================================
+  // Test Fixture
+  // ============================================================================
+
+  class SnapshotTest : public ::testing::Test {
+   protected:
+    xccmeta::parser p;
+    xccmeta::compile_args args = xccmeta::compile_args::modern_cxx();
+    xccmeta::node_ptr root;
+
+    void SetUp() override {
+      root = p.parse(R"(
+        namespace app {
+          /// @reflect
+          struct Player {
+            int health;
+            void update();
+          };
+
+          struct Forward;
+          struct Forward {
+            int value;
+          };
+
+          enum class Mode { On, Off };
+        }
+      )",
+                     args);
+      ASSERT_NE(root, nullptr);
+    }
+  };
+
+  // ============================================================================
+  // Construction
+  // ============================================================================
+
+  TEST(SnapshotBasicTest, NullRootIsEmpty) {
+    auto snap = xccmeta::freeze(nullptr);
+    EXPECT_TRUE(snap.empty());
+    EXPECT_EQ(snap.size(), 0u);
+    EXPECT_EQ(snap.get_root(), xccmeta::snapshot::invalid_handle);
+    EXPECT_TRUE(snap.get_nodes().empty());
+    EXPECT_EQ(snap.find_by_usr("c:@S@X"), xccmeta::snapshot::invalid_handle);
+  }
+
+  TEST_F(SnapshotTest, NodesArePreorder) {
+    auto snap = xccmeta::freeze(root);
+    ASSERT_FALSE(snap.empty());
+    EXPECT_EQ(snap.get_root(), 0u);
+    EXPECT_EQ(snap.get_root_node(), root);
+    EXPECT_EQ(&snap.get(0), root.get());
+
+    std::vector<const xccmeta::node*> expected;
+    expected.push_back(root.get());
+    for (const auto& n : root->find_descendants([](const xccmeta::node_ptr&) { return true; })) expected.push_back(n.get());
+
+    ASSERT_EQ(snap.size(), expected.size());
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+      EXPECT_EQ(snap.get_nodes()[i], expected[i]);
+      EXPECT_EQ(snap.find(expected[i]), i);
+    }
+  }
+
+  // ============================================================================
+  // Navigation
+  // ============================================================================
+
+  TEST_F(SnapshotTest, ChildrenAndParentsMatchTree) {
+    auto snap = xccmeta::freeze(root);
+    for (xccmeta::snapshot::handle h = 0; h < snap.size(); ++h) {
+      const auto& n = snap.get(h);
+      auto children = snap.get_children(h);
+      ASSERT_EQ(children.size(), n.get_children().size());
+      for (std::size_t i = 0; i < children.size(); ++i) {
+        EXPECT_EQ(&snap.get(children[i]), n.get_children()[i].get());
+        EXPECT_EQ(snap.get_parent(children[i]), h);
+        EXPECT_EQ(snap.get_depth(children[i]), snap.get_depth(h) + 1);
+      }
+    }
+    EXPECT_EQ(snap.get_parent(0), xccmeta::snapshot::invalid_handle);
+    EXPECT_EQ(snap.get_depth(0), 0u);
+  }
+
+  TEST_F(SnapshotTest, SubtreeRangesCoverDescendants) {
+    auto snap = xccmeta::freeze(root);
+    EXPECT_EQ(snap.get_subtree_size(0), snap.size());
+
+    auto player = snap.find_by_usr("c:@N@app@S@Player");
+    ASSERT_NE(player, xccmeta::snapshot::invalid_handle);
+    const auto& player_node = snap.get(player);
+    EXPECT_EQ(snap.get_subtree_size(player), player_node.find_descendants([](const xccmeta::node_ptr&) { return true; }).size() + 1);
+
+    for (auto child : snap.get_children(player)) {
+      EXPECT_TRUE(snap.is_ancestor(player, child));
+      EXPECT_TRUE(snap.is_ancestor(0, child));
+      EXPECT_FALSE(snap.is_ancestor(child, player));
+    }
+    EXPECT_FALSE(snap.is_ancestor(player, player));
+  }
+
+  // ============================================================================
+  // Lookup
+  // ============================================================================
+
+  TEST_F(SnapshotTest, FindByUsrPrefersDefinition) {
+    auto snap = xccmeta::freeze(root);
+    auto h = snap.find_by_usr("c:@N@app@S@Forward");
+    ASSERT_NE(h, xccmeta::snapshot::invalid_handle);
+    EXPECT_TRUE(snap.get(h).is_definition());
+    EXPECT_EQ(snap.get(h).get_children().size(), 1u);
+  }
+
+  TEST_F(SnapshotTest, FindUnknownReturnsInvalid) {
+    auto snap = xccmeta::freeze(root);
+    EXPECT_EQ(snap.find_by_usr("c:@S@DoesNotExist"), xccmeta::snapshot::invalid_handle);
+    EXPECT_EQ(snap.find_by_usr(""), xccmeta::snapshot::invalid_handle);
+
+    auto other = p.parse("struct Other {};", args);
+    ASSERT_NE(other, nullptr);
+    EXPECT_EQ(snap.find(other.get()), xccmeta::snapshot::invalid_handle);
+  }
+
+  TEST_F(SnapshotTest, CopiesShareData) {
+    auto snap = xccmeta::freeze(root);
+    xccmeta::snapshot copy = snap;
+    EXPECT_EQ(copy.size(), snap.size());
+    EXPECT_EQ(copy.get_nodes().data(), snap.get_nodes().data());
+  }
+
+  // ============================================================================
+  // Concurrency
+  // ============================================================================
+
+  TEST_F(SnapshotTest, ConcurrentReadersSeeSameData) {
+    auto snap = xccmeta::freeze(root);
+    const auto player = snap.find_by_usr("c:@N@app@S@Player");
+    ASSERT_NE(player, xccmeta::snapshot::invalid_handle);
+
+    std::atomic<int> mismatches {0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+      threads.emplace_back([&] {
+        for (int iter = 0; iter < 100; ++iter) {
+          for (const auto* n : snap.get_nodes()) {
+            auto tags = n->get_all_tags_view();
+            for (const auto& child : snap.get_children(snap.find(n))) {
+              if (snap.get(child).get_all_tags_view().size() < tags.size()) mismatches++;
+            }
+          }
+          if (snap.find_by_usr("c:@N@app@S@Player") != player) mismatches++;
+        }
+      });
+    }
+    for (auto& t : threads) t.join();
+    EXPECT_EQ(mismatches.load(), 0);
+  }
+
+}  // namespace
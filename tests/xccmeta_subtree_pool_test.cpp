@@ -0,0 +1,260 @@
+/*
+MIT License
+
+Copyright (c) 2026 Christian Luppi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <xccmeta/xccmeta_parser.hpp>
+#include <xccmeta/xccmeta_subtree_pool.hpp>
+
+#include <string>
+
+namespace {
+
+  // Both inputs start with the same "header", so its nodes get identical locations
+  const std::string header = R"(namespace lib {
+  struct Vec { float x, y; };
+  struct Body { Vec position; Vec velocity; };
+}
+)";
+
+  class SubtreePoolTest : public ::testing::Test {
+   protected:
+    xccmeta::parser p;
+    xccmeta::compile_args args = xccmeta::compile_args::modern_cxx();
+
+    xccmeta::node_ptr parse(const std::string& code) {
+      return p.parse(code, args);
+    }
+
+    static xccmeta::node_ptr child_named(const xccmeta::node_ptr& n, const std::string& name) {
+      for (const auto& child : n->get_children()) {
+        if (child->get_name() == name) return child;
+      }
+      return nullptr;
+    }
+  };
+
+  // ============================================================================
+  // Interning Tests
+  // ============================================================================
+
+  TEST_F(SubtreePoolTest, IdenticalSubtreesAreShared) {
+    auto a = parse(header + "struct OnlyA {};");
+    auto b = parse(header + "struct OnlyB { int v; };");
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+    const auto b_hash = b->get_hash_with_locations();
+    auto lib_a = child_named(a, "lib");
+    auto lib_b = child_named(b, "lib");
+    const auto lib_nodes = lib_a->find_descendants([](auto&) { return true; }).size();
+
+    xccmeta::subtree_pool pool;
+    EXPECT_EQ(pool.intern(a), 0);
+    EXPECT_EQ(pool.intern(b), lib_nodes);  // Everything below the namespace
+
+    // Declarations are shared, the namespace stays per root
+    EXPECT_NE(lib_b, lib_a);
+    EXPECT_EQ(child_named(lib_b, "Vec"), child_named(lib_a, "Vec"));
+    EXPECT_EQ(child_named(lib_b, "Body"), child_named(lib_a, "Body"));
+    EXPECT_TRUE(pool.contains(child_named(lib_b, "Vec")));
+    EXPECT_FALSE(pool.contains(lib_b));
+    EXPECT_TRUE(child_named(lib_b, "Vec")->is_shared());
+    EXPECT_FALSE(child_named(b, "OnlyB")->is_shared());
+    EXPECT_EQ(lib_b->get_parent(), b);
+    EXPECT_EQ(b->get_hash_with_locations(), b_hash);
+    EXPECT_EQ(b->get_children().size(), 2);
+
+    EXPECT_EQ(pool.intern(b), 0);  // Already shared
+  }
+
+  TEST_F(SubtreePoolTest, SharesInsideDifferingParents) {
+    auto a = parse("namespace lib {\n  struct Vec { float x, y; };\n  struct OnlyA {};\n}");
+    auto b = parse("namespace lib {\n  struct Vec { float x, y; };\n  struct OnlyB {};\n}");
+
+    xccmeta::subtree_pool pool;
+    pool.intern(a);
+    pool.intern(b);
+
+    auto lib_a = child_named(a, "lib");
+    auto lib_b = child_named(b, "lib");
+    EXPECT_NE(lib_a, lib_b);
+    EXPECT_EQ(child_named(lib_a, "Vec"), child_named(lib_b, "Vec"));
+    EXPECT_NE(child_named(lib_b, "OnlyB"), nullptr);
+    EXPECT_EQ(lib_b->get_children_by_kind(xccmeta::node::kind::struct_decl).size(), 2);
+  }
+
+  TEST_F(SubtreePoolTest, TypeLinksFollowSharedNodes) {
+    auto a = parse(header);
+    auto b = parse(header + "struct User { lib::Vec v; };");
+
+    xccmeta::subtree_pool pool;
+    pool.intern(a);
+    pool.intern(b);
+
+    auto field = child_named(child_named(b, "User"), "v");
+    ASSERT_NE(field, nullptr);
+    auto decl = field->get_type_declaration();
+    ASSERT_NE(decl, nullptr);
+    EXPECT_EQ(decl, child_named(child_named(a, "lib"), "Vec"));
+  }
+
+  TEST_F(SubtreePoolTest, ClearForgetsInstances) {
+    auto a = parse(header);
+    xccmeta::subtree_pool pool;
+    pool.intern(a);
+    EXPECT_GT(pool.size(), 0);
+    pool.clear();
+    EXPECT_EQ(pool.size(), 0);
+    EXPECT_FALSE(pool.contains(child_named(child_named(a, "lib"), "Vec")));
+    EXPECT_EQ(pool.intern(nullptr), 0);
+  }
+
+  TEST_F(SubtreePoolTest, DroppedTreesAreNotKeptAlive) {
+    auto a = parse(header);
+    xccmeta::subtree_pool pool;
+    pool.intern(a);
+    EXPECT_EQ(pool.size(), 2);  // Vec, Body
+
+    std::weak_ptr<xccmeta::node> vec = child_named(child_named(a, "lib"), "Vec");
+    a.reset();
+    EXPECT_TRUE(vec.expired());
+    EXPECT_EQ(pool.size(), 0);
+
+    auto b = parse(header);
+    EXPECT_EQ(pool.intern(b), 0);  // Nothing left to share with
+    EXPECT_EQ(pool.size(), 2);
+  }
+
+  TEST_F(SubtreePoolTest, DifferentInheritedTagsAreNotShared) {
+    // Same length comments, so Vec gets the same location in both
+    auto a = parse("/// @tag_a\nnamespace lib {\n  struct Vec { float x, y; };\n}");
+    auto b = parse("/// @tag_b\nnamespace lib {\n  struct Vec { float x, y; };\n}");
+
+    auto vec_a = child_named(child_named(a, "lib"), "Vec");
+    auto vec_b = child_named(child_named(b, "lib"), "Vec");
+    ASSERT_NE(vec_b, nullptr);
+    ASSERT_EQ(vec_a->get_hash_with_locations(), vec_b->get_hash_with_locations());
+
+    xccmeta::subtree_pool pool;
+    pool.intern(a);
+    EXPECT_EQ(pool.intern(b), 0);
+
+    EXPECT_EQ(child_named(child_named(b, "lib"), "Vec"), vec_b);
+    EXPECT_FALSE(vec_b->is_shared());
+    ASSERT_EQ(vec_b->get_parent_tags().size(), 1);
+    EXPECT_EQ(vec_b->get_parent_tags()[0].get_name(), "tag_b");
+    EXPECT_EQ(pool.size(), 2);
+  }
+
+  TEST_F(SubtreePoolTest, SharedNodesKeepParentsAndTags) {
+    auto a = parse("/// @reflect\nnamespace lib {\n  struct Vec { float x, y; };\n  struct OnlyA {};\n}");
+    auto b = parse("/// @reflect\nnamespace lib {\n  struct Vec { float x, y; };\n  struct OnlyB {};\n}");
+
+    xccmeta::subtree_pool pool;
+    pool.intern(a);
+    pool.intern(b);
+
+    auto vec = child_named(child_named(b, "lib"), "Vec");
+    ASSERT_TRUE(vec->is_shared());
+    EXPECT_EQ(vec, child_named(child_named(a, "lib"), "Vec"));
+    EXPECT_EQ(vec->get_parent(), nullptr);  // Held by both, parented by neither
+    EXPECT_EQ(vec->get_qualified_name(), "lib::Vec");
+
+    a.reset();  // Inherited tags do not depend on the first root
+    ASSERT_EQ(vec->get_parent_tags().size(), 1);
+    EXPECT_EQ(vec->get_parent_tags()[0].get_name(), "reflect");
+    auto x = child_named(vec, "x");
+    ASSERT_NE(x, nullptr);
+    EXPECT_EQ(x->get_parent(), vec);
+    EXPECT_EQ(x->get_parent_tags().size(), 1);
+  }
+
+  TEST_F(SubtreePoolTest, MergeLeavesOtherRootsIntact) {
+    auto a = parse(header + "struct OnlyA {};");
+    auto b = parse(header + "struct OnlyB {};");
+    auto c = parse(header + "struct OnlyC {};");
+
+    xccmeta::subtree_pool pool;
+    pool.intern(a);
+    pool.intern(b);
+    pool.intern(c);
+
+    auto vec = child_named(child_named(c, "lib"), "Vec");
+    const auto vec_children = vec->get_children().size();
+    ASSERT_GT(vec_children, 0);
+
+    auto merged = p.merge_all({a, b}, args);  // Moves out of a and b
+    ASSERT_NE(merged, nullptr);
+    auto merged_vec = child_named(child_named(merged, "lib"), "Vec");
+    ASSERT_NE(merged_vec, nullptr);
+    EXPECT_NE(merged_vec, vec);  // Cloned, not moved
+    EXPECT_EQ(merged_vec->get_parent(), child_named(merged, "lib"));
+
+    // c still sees the full shared subtree
+    EXPECT_EQ(child_named(child_named(c, "lib"), "Vec"), vec);
+    EXPECT_EQ(vec->get_children().size(), vec_children);
+    EXPECT_NE(child_named(c, "lib")->get_children().size(), 0);
+    EXPECT_EQ(child_named(vec, "x")->get_parent(), vec);
+  }
+
+  // ============================================================================
+  // node_path Tests
+  // ============================================================================
+
+  TEST_F(SubtreePoolTest, PathNavigation) {
+    auto b = parse("struct First {};\n" + header);
+    ASSERT_NE(b, nullptr);
+
+    xccmeta::node_path path(b);
+    EXPECT_EQ(path.get_depth(), 0);
+    EXPECT_EQ(path.get_parent(), nullptr);
+    EXPECT_FALSE(path.to_parent());
+    EXPECT_FALSE(path.to_child(5));
+
+    ASSERT_TRUE(path.to_child(1));
+    EXPECT_EQ(path.get_node()->get_name(), "lib");
+    EXPECT_EQ(path.get_parent(), b);
+    EXPECT_EQ(path.get_depth(), 1);
+    EXPECT_TRUE(path.to_parent());
+    EXPECT_EQ(path.get_node(), b);
+  }
+
+  TEST_F(SubtreePoolTest, PathParentOfSharedNode) {
+    auto a = parse(header + "struct OnlyA {};");
+    auto b = parse(header + "struct OnlyB {};");
+
+    xccmeta::subtree_pool pool;
+    pool.intern(a);
+    pool.intern(b);
+
+    xccmeta::node_path path(b);
+    ASSERT_TRUE(path.to_child(0));
+    ASSERT_TRUE(path.to_child(0));
+    EXPECT_EQ(path.get_node()->get_name(), "Vec");
+    EXPECT_TRUE(path.get_node()->is_shared());
+    EXPECT_EQ(path.get_parent(), child_named(b, "lib"));
+    EXPECT_EQ(path.get_node()->get_parent(), nullptr);
+    EXPECT_EQ(path.get_root(), b);
+  }
+
+}  // namespace
@@ -373,4 +373,30 @@ namespace {
     EXPECT_EQ(t.get_full(), "xccmeta::test(a, b, c)");
   }
 
+  // Test that the same name always interns to the same id
+  TEST(TagTest, InternIsStable) {
+    auto a = xccmeta::tag::intern("xccmeta::interned_a");
+    auto b = xccmeta::tag::intern("xccmeta::interned_b");
+    EXPECT_NE(a, b);
+    EXPECT_EQ(xccmeta::tag::intern("xccmeta::interned_a"), a);
+    EXPECT_EQ(xccmeta::tag::lookup("xccmeta::interned_b"), b);
+    EXPECT_EQ(xccmeta::tag::name_of(a), "xccmeta::interned_a");
+  }
+
+  // Test lookup of a name that was never interned
+  TEST(TagTest, LookupUnknownName) {
+    EXPECT_EQ(xccmeta::tag::lookup("xccmeta::never_interned_name"), xccmeta::tag::invalid_id);
+    EXPECT_EQ(xccmeta::tag::mask_of(xccmeta::tag::invalid_id), 0u);
+    EXPECT_TRUE(xccmeta::tag::name_of(xccmeta::tag::invalid_id).empty());
+  }
+
+  // Test that constructed and parsed tags carry the interned id of their name
+  TEST(TagTest, TagsCarryInternedId) {
+    xccmeta::tag constructed("xccmeta::serialize", {"json"});
+    auto parsed = xccmeta::tag::parse("xccmeta::serialize(binary)");
+    EXPECT_EQ(constructed.get_id(), parsed.get_id());
+    EXPECT_EQ(constructed.get_id(), xccmeta::tag::lookup("xccmeta::serialize"));
+    EXPECT_EQ(xccmeta::tag().get_id(), xccmeta::tag::intern(""));
+  }
+
 }  // namespace
\ No newline at end of file
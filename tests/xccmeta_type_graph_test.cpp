@@ -0,0 +1,229 @@
+/*
+MIT License
+
+Copyright (c) 2026 Christian Luppi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <xccmeta/xccmeta_parser.hpp>
+#include <xccmeta/xccmeta_type_graph.hpp>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace {
+
+  // ============================================================================
+  // Test Fixture
+  // ============================================================================
+
+  class TypeGraphTest : public ::testing::Test {
+   protected:
+    xccmeta::parser p;
+    xccmeta::compile_args args = xccmeta::compile_args::modern_cxx();
+
+    xccmeta::node_ptr parse(const std::string& code) {
+      auto root = p.parse(code, args);
+      EXPECT_NE(root, nullptr);
+      return root;
+    }
+
+    static std::vector<std::string> names(const xccmeta::type_graph& g, const std::vector<xccmeta::type_graph::vertex>& vs) {
+      std::vector<std::string> result;
+      for (auto v : vs) result.push_back(g.get_node(v)->get_name());
+      return result;
+    }
+
+    static std::size_t position(const std::vector<std::string>& order, const std::string& name) {
+      return static_cast<std::size_t>(std::find(order.begin(), order.end(), name) - order.begin());
+    }
+  };
+
+  // ============================================================================
+  // Construction
+  // ============================================================================
+
+  TEST_F(TypeGraphTest, EmptyGraph) {
+    xccmeta::type_graph g;
+    EXPECT_EQ(g.size(), 0u);
+    EXPECT_TRUE(g.get_topological_order().empty());
+    EXPECT_FALSE(g.has_cycles());
+    EXPECT_EQ(g.find("c:@S@Missing"), xccmeta::type_graph::invalid_vertex);
+  }
+
+  TEST_F(TypeGraphTest, CollectsTypeDeclarations) {
+    auto root = parse(R"(
+      struct A { int x; };
+      enum class Mode { On, Off };
+      typedef A AliasA;
+      template <typename T> struct Box { T value; };
+      void not_a_type();
+    )");
+    xccmeta::type_graph g(root);
+    EXPECT_EQ(g.size(), 4u);
+    EXPECT_NE(g.find("c:@S@A"), xccmeta::type_graph::invalid_vertex);
+    EXPECT_EQ(g.get_usr(g.find("c:@S@A")), "c:@S@A");
+  }
+
+  TEST_F(TypeGraphTest, PrefersDefinitions) {
+    auto root = parse(R"(
+      struct Later;
+      struct User { Later* ptr; };
+      struct Later { int v; };
+    )");
+    xccmeta::type_graph g(root);
+    auto later = g.find("c:@S@Later");
+    ASSERT_NE(later, xccmeta::type_graph::invalid_vertex);
+    EXPECT_TRUE(g.get_node(later)->is_definition());
+  }
+
+  // ============================================================================
+  // Edges
+  // ============================================================================
+
+  TEST_F(TypeGraphTest, FieldsBasesAndTemplateArgumentsAreEdges) {
+    auto root = parse(R"(
+      struct Base {};
+      struct Part {};
+      struct Tag {};
+      template <typename T> struct Box { T value; };
+      struct Whole : Base {
+        Part parts[2];
+        Box<Tag> boxed;
+      };
+    )");
+    xccmeta::type_graph g(root);
+    auto deps = names(g, g.get_dependencies(g.find("c:@S@Whole")));
+    std::sort(deps.begin(), deps.end());
+    EXPECT_EQ(deps, (std::vector<std::string> {"Base", "Box", "Part", "Tag"}));
+
+    auto dependents = names(g, g.get_dependents(g.find("c:@S@Part")));
+    EXPECT_EQ(dependents, (std::vector<std::string> {"Whole"}));
+  }
+
+  TEST_F(TypeGraphTest, TransitiveDependenciesComeFirst) {
+    auto root = parse(R"(
+      struct C { int v; };
+      struct B { C c; };
+      struct A { B b; };
+    )");
+    xccmeta::type_graph g(root);
+    EXPECT_EQ(names(g, g.get_transitive_dependencies(g.find("c:@S@A"))), (std::vector<std::string> {"C", "B"}));
+    EXPECT_TRUE(g.get_transitive_dependencies(g.find("c:@S@C")).empty());
+  }
+
+  // ============================================================================
+  // Orderings
+  // ============================================================================
+
+  TEST_F(TypeGraphTest, TopologicalOrderPutsDependenciesFirst) {
+    auto root = parse(R"(
+      struct Player;
+      struct Inventory { struct Item* items; };
+      struct Item { int id; };
+      struct Player { Inventory inventory; };
+      typedef Player PlayerAlias;
+    )");
+    xccmeta::type_graph g(root);
+    EXPECT_FALSE(g.has_cycles());
+
+    auto order = names(g, g.get_topological_order());
+    ASSERT_EQ(order.size(), g.size());
+    EXPECT_LT(position(order, "Item"), position(order, "Inventory"));
+    EXPECT_LT(position(order, "Inventory"), position(order, "Player"));
+    EXPECT_LT(position(order, "Player"), position(order, "PlayerAlias"));
+  }
+
+  TEST_F(TypeGraphTest, CyclesFormOneComponent) {
+    auto root = parse(R"(
+      struct B;
+      struct A { B* b; };
+      struct B { A* a; };
+      struct Leaf { int v; };
+      struct Owner { A a; Leaf leaf; };
+      struct Self { Self* next; };
+    )");
+    xccmeta::type_graph g(root);
+    EXPECT_TRUE(g.has_cycles());
+
+    auto components = g.get_strongly_connected_components();
+    auto cycle = std::find_if(components.begin(), components.end(), [](const auto& c) { return c.size() > 1; });
+    ASSERT_NE(cycle, components.end());
+    auto cycle_names = names(g, *cycle);
+    std::sort(cycle_names.begin(), cycle_names.end());
+    EXPECT_EQ(cycle_names, (std::vector<std::string> {"A", "B"}));
+
+    auto order = names(g, g.get_topological_order());
+    EXPECT_LT(position(order, "A"), position(order, "Owner"));
+    EXPECT_LT(position(order, "Leaf"), position(order, "Owner"));
+    EXPECT_TRUE(g.get_dependencies(g.find("c:@S@Self")).empty());
+  }
+
+  TEST_F(TypeGraphTest, OrderIsDeterministic) {
+    const char* code = R"(
+      struct D {}; struct C { D d; }; struct B { D d; }; struct A { B b; C c; };
+    )";
+    xccmeta::type_graph g1(parse(code));
+    xccmeta::type_graph g2(parse(code));
+    EXPECT_EQ(names(g1, g1.get_topological_order()), names(g2, g2.get_topological_order()));
+  }
+
+  // ============================================================================
+  // Incremental updates
+  // ============================================================================
+
+  TEST_F(TypeGraphTest, UpdateReplacesOneFile) {
+    auto shared = parse("struct Config { int level; };");
+    auto old_file = parse("struct Config; struct Widget { Config* config; };");
+    xccmeta::type_graph g;
+    g.add(shared);
+    g.add(old_file);
+
+    auto widget = g.find("c:@S@Widget");
+    ASSERT_NE(widget, xccmeta::type_graph::invalid_vertex);
+    EXPECT_EQ(names(g, g.get_dependencies(widget)), (std::vector<std::string> {"Config"}));
+
+    auto new_file = parse("struct Config; struct Gadget { Config config; }; struct Widget { Gadget gadget; };");
+    g.update(old_file, new_file);
+
+    EXPECT_EQ(g.find("c:@S@Widget"), widget);  // Ids are stable
+    EXPECT_EQ(names(g, g.get_dependencies(widget)), (std::vector<std::string> {"Gadget"}));
+    EXPECT_EQ(names(g, g.get_transitive_dependencies(widget)), (std::vector<std::string> {"Config", "Gadget"}));
+    EXPECT_TRUE(g.get_node(g.find("c:@S@Config"))->is_definition());
+  }
+
+  TEST_F(TypeGraphTest, RemoveDropsTypesOnlyThatRootDeclared) {
+    auto a = parse("struct Common { int x; }; struct OnlyA { Common c; };");
+    auto b = parse("struct Common { int x; }; struct OnlyB { Common c; };");
+    xccmeta::type_graph g;
+    g.add(a);
+    g.add(b);
+    EXPECT_EQ(g.size(), 3u);
+
+    g.remove(a);
+    EXPECT_EQ(g.size(), 2u);
+    EXPECT_EQ(g.find("c:@S@OnlyA"), xccmeta::type_graph::invalid_vertex);
+    EXPECT_NE(g.find("c:@S@Common"), xccmeta::type_graph::invalid_vertex);
+    EXPECT_EQ(names(g, g.get_dependents(g.find("c:@S@Common"))), (std::vector<std::string> {"OnlyB"}));
+  }
+
+}  // namespace
@@ -0,0 +1,160 @@
+/*
+MIT License
+
+Copyright (c) 2026 Christian Luppi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <xccmeta/xccmeta_parser.hpp>
+#include <xccmeta/xccmeta_usr_registry.hpp>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+  std::size_t count_named(const xccmeta::node_ptr& root, const std::string& name) {
+    return root->find_descendants([&](const xccmeta::node_ptr& n) { return n->get_name() == name; }).size();
+  }
+
+  // ============================================================================
+  // Claim Tests
+  // ============================================================================
+
+  TEST(UsrRegistryTest, FirstDeclarationIsGranted) {
+    xccmeta::usr_registry registry;
+    EXPECT_TRUE(registry.claim("c:@S@A", false));
+    EXPECT_FALSE(registry.claim("c:@S@A", false));
+    EXPECT_TRUE(registry.contains("c:@S@A"));
+    EXPECT_FALSE(registry.has_definition("c:@S@A"));
+    EXPECT_FALSE(registry.contains("c:@S@B"));
+    EXPECT_EQ(registry.size(), 1);
+  }
+
+  TEST(UsrRegistryTest, FirstDefinitionIsGrantedAfterDeclaration) {
+    xccmeta::usr_registry registry;
+    EXPECT_TRUE(registry.claim("c:@S@A", false));
+    EXPECT_TRUE(registry.claim("c:@S@A", true));
+    EXPECT_TRUE(registry.has_definition("c:@S@A"));
+    EXPECT_FALSE(registry.claim("c:@S@A", true));
+    EXPECT_FALSE(registry.claim("c:@S@A", false));
+
+    registry.clear();
+    EXPECT_EQ(registry.size(), 0);
+    EXPECT_TRUE(registry.claim("c:@S@A", true));
+  }
+
+  TEST(UsrRegistryTest, ConcurrentClaimsGrantEachUsrOnce) {
+    xccmeta::usr_registry registry;
+    std::atomic<int> granted {0};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+      threads.emplace_back([&] {
+        for (int i = 0; i < 500; ++i) {
+          if (registry.claim("c:@S@T" + std::to_string(i), true)) granted++;
+        }
+      });
+    }
+    for (auto& t : threads) t.join();
+
+    EXPECT_EQ(granted.load(), 500);
+    EXPECT_EQ(registry.size(), 500);
+  }
+
+  // ============================================================================
+  // Parser Integration Tests
+  // ============================================================================
+
+  TEST(UsrRegistryTest, ParseSkipsClaimedDeclarations) {
+    xccmeta::parser p;
+    xccmeta::compile_args args = xccmeta::compile_args::modern_cxx();
+    xccmeta::usr_registry registry;
+
+    const std::string header = "namespace lib { struct Shared { int a; int b; }; void helper(); }";
+    auto first = p.parse(header + " struct One {};", args, registry);
+    auto second = p.parse(header + " struct Two {};", args, registry);
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+
+    EXPECT_EQ(count_named(first, "Shared"), 1);
+    EXPECT_EQ(count_named(first, "a"), 1);
+    EXPECT_EQ(count_named(second, "Shared"), 0);
+    EXPECT_EQ(count_named(second, "a"), 0);  // Members are skipped with their owner
+    EXPECT_EQ(count_named(second, "helper"), 0);
+    EXPECT_EQ(count_named(second, "lib"), 1);  // Namespaces are never claimed
+    EXPECT_EQ(count_named(second, "Two"), 1);
+
+    auto merged = p.merge_all({first, second}, args);
+    EXPECT_EQ(count_named(merged, "Shared"), 1);
+    EXPECT_EQ(count_named(merged, "One"), 1);
+    EXPECT_EQ(count_named(merged, "Two"), 1);
+  }
+
+  TEST(UsrRegistryTest, DefinitionIsBuiltAfterForwardDeclaration) {
+    xccmeta::parser p;
+    xccmeta::compile_args args = xccmeta::compile_args::modern_cxx();
+    xccmeta::usr_registry registry;
+
+    auto first = p.parse("struct Item; struct Item;", args, registry);
+    auto second = p.parse("struct Item { int id; };", args, registry);
+    EXPECT_EQ(count_named(first, "Item"), 1);
+    EXPECT_EQ(count_named(second, "Item"), 1);
+
+    auto merged = p.merge_all({first, second}, args);
+    ASSERT_EQ(merged->get_children().size(), 1);
+    EXPECT_TRUE(merged->get_children()[0]->is_definition());
+  }
+
+  TEST(UsrRegistryTest, ParallelParsesBuildEachDeclarationOnce) {
+    xccmeta::compile_args args = xccmeta::compile_args::modern_cxx();
+    xccmeta::usr_registry registry;
+
+    const std::string header = "namespace lib { struct Shared { int a; }; enum class Mode { A }; }";
+    std::vector<xccmeta::node_ptr> roots(8);
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < roots.size(); ++i) {
+      threads.emplace_back([&, i] {
+        xccmeta::parser p;
+        roots[i] = p.parse(header + " struct Own" + std::to_string(i) + " {};", args, registry);
+      });
+    }
+    for (auto& t : threads) t.join();
+
+    std::size_t shared = 0;
+    for (const auto& root : roots) {
+      ASSERT_NE(root, nullptr);
+      shared += count_named(root, "Shared");
+    }
+    EXPECT_EQ(shared, 1);
+
+    xccmeta::parser p;
+    auto merged = p.merge_all(roots, args);
+    EXPECT_EQ(count_named(merged, "Shared"), 1);
+    EXPECT_EQ(count_named(merged, "Mode"), 1);
+    for (std::size_t i = 0; i < roots.size(); ++i) {
+      EXPECT_EQ(count_named(merged, "Own" + std::to_string(i)), 1);
+    }
+  }
+
+}  // namespace
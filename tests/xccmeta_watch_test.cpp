@@ -0,0 +1,270 @@
+/*
+MIT License
+
+Copyright (c) 2026 Christian Luppi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <xccmeta/xccmeta_watch.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+  // Unique temporary directory, removed with its contents on destruction
+  class TempDirectory {
+   public:
+    TempDirectory() {
+      static std::atomic<int> counter {0};
+      dir = std::filesystem::temp_directory_path() /
+            ("xccmeta_watch_test_" + std::to_string(counter.fetch_add(1)) + "_" +
+             std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+      std::filesystem::create_directories(dir);
+    }
+
+    ~TempDirectory() {
+      std::error_code ec;
+      std::filesystem::remove_all(dir, ec);
+    }
+
+    void write(const std::string& name, const std::string& content) const {
+      std::ofstream(dir / name, std::ios::binary) << content;
+    }
+
+    const std::filesystem::path& path() const { return dir; }
+
+   private:
+    std::filesystem::path dir;
+  };
+
+  // Watches dir/*.hpp with dir on the include path and records what each update reported
+  struct recorded_watcher {
+    explicit recorded_watcher(const TempDirectory& tmp) {
+      xccmeta::watcher::config cfg;
+      cfg.inputs.patterns = {(tmp.path() / "*.hpp").generic_string()};
+      cfg.args = xccmeta::compile_args::modern_cxx();
+      cfg.args.add_include_path(tmp.path().string());
+      cfg.debounce = std::chrono::milliseconds(20);
+      cfg.on_parsed = [this](const xccmeta::file& input, xccmeta::node_ptr root) {
+        EXPECT_NE(root, nullptr);
+        parsed.push_back(input.get_path().filename().string());
+      };
+      cfg.on_removed = [this](const std::filesystem::path& input) { removed.push_back(input.filename().string()); };
+      cfg.on_batch = [this](const xccmeta::watcher::batch& changes) {
+        EXPECT_EQ(changes.parsed.size(), parsed.size());
+        batches++;
+      };
+      instance = std::make_unique<xccmeta::watcher>(cfg);
+    }
+
+    // Runs one update and returns the inputs it parsed
+    std::vector<std::string> update() {
+      parsed.clear();
+      removed.clear();
+      instance->update();
+      return parsed;
+    }
+
+    std::unique_ptr<xccmeta::watcher> instance;
+    std::vector<std::string> parsed;
+    std::vector<std::string> removed;
+    int batches = 0;
+  };
+
+  using names = std::vector<std::string>;
+
+  // ============================================================================
+  // Incremental Updates
+  // ============================================================================
+
+  TEST(WatcherTest, FirstUpdateParsesEverything) {
+    TempDirectory tmp;
+    tmp.write("a.hpp", "struct a {};");
+    tmp.write("b.hpp", "struct b {};");
+    tmp.write("notes.txt", "not an input");
+
+    recorded_watcher w(tmp);
+    EXPECT_EQ(w.update(), (names {"a.hpp", "b.hpp"}));
+    EXPECT_NE(w.instance->get_root(tmp.path() / "a.hpp"), nullptr);
+    EXPECT_EQ(w.instance->get_root(tmp.path() / "notes.txt"), nullptr);
+
+    // Nothing changed: no parse and no callbacks
+    EXPECT_EQ(w.update(), names {});
+    EXPECT_EQ(w.batches, 1);
+  }
+
+  TEST(WatcherTest, OnlyChangedAddedAndRemovedInputsAreReported) {
+    TempDirectory tmp;
+    tmp.write("a.hpp", "struct a {};");
+    tmp.write("b.hpp", "struct b {};");
+    tmp.write("c.hpp", "struct c {};");
+
+    recorded_watcher w(tmp);
+    w.update();
+    const auto a_root = w.instance->get_root(tmp.path() / "a.hpp");
+
+    tmp.write("b.hpp", "struct b { int x; };");
+    tmp.write("c.hpp", "struct c {};");  // Same bytes rewritten
+    EXPECT_EQ(w.update(), names {"b.hpp"});
+    EXPECT_EQ(w.instance->get_root(tmp.path() / "a.hpp"), a_root);  // Kept from the first parse
+
+    tmp.write("d.hpp", "struct d {};");
+    std::filesystem::remove(tmp.path() / "a.hpp");
+    EXPECT_EQ(w.update(), names {"d.hpp"});
+    EXPECT_EQ(w.removed, names {"a.hpp"});
+    EXPECT_EQ(w.instance->get_root(tmp.path() / "a.hpp"), nullptr);
+  }
+
+  TEST(WatcherTest, ChangedHeaderReparsesIncludingInputs) {
+    TempDirectory tmp;
+    tmp.write("common.h", "struct common {};");
+    tmp.write("a.hpp", "#include \"common.h\"\nstruct a { common c; };");
+    tmp.write("b.hpp", "struct b {};");
+
+    recorded_watcher w(tmp);
+    w.update();
+    const auto common = std::filesystem::weakly_canonical(tmp.path() / "common.h");
+    EXPECT_EQ(w.instance->get_dependencies(tmp.path() / "a.hpp"), std::vector<std::filesystem::path> {common});
+    EXPECT_TRUE(w.instance->get_dependencies(tmp.path() / "b.hpp").empty());
+
+    tmp.write("common.h", "struct common { int added; };");
+    EXPECT_EQ(w.update(), names {"a.hpp"});
+    const auto root = w.instance->get_root(tmp.path() / "a.hpp");
+    EXPECT_FALSE(root->find_descendants([](const xccmeta::node_ptr& n) { return n->get_name() == "added"; }).empty());
+
+    EXPECT_EQ(w.update(), names {});
+  }
+
+  TEST(WatcherTest, InputIncludedByAnotherInput) {
+    TempDirectory tmp;
+    tmp.write("base.hpp", "struct base {};");
+    tmp.write("derived.hpp", "#include \"base.hpp\"\nstruct derived : base {};");
+
+    recorded_watcher w(tmp);
+    w.update();
+
+    tmp.write("base.hpp", "struct base { virtual ~base(); };");
+    EXPECT_EQ(w.update(), (names {"base.hpp", "derived.hpp"}));
+  }
+
+  // ============================================================================
+  // File Events
+  // ============================================================================
+
+  TEST(WatcherTest, PollPicksUpSavedFile) {
+    if (!xccmeta::watcher::is_supported()) GTEST_SKIP() << "No file events on this platform";
+
+    TempDirectory tmp;
+    tmp.write("a.hpp", "struct a {};");
+    tmp.write("b.hpp", "struct b {};");
+
+    recorded_watcher w(tmp);
+    w.update();
+    w.parsed.clear();
+
+    tmp.write("b.hpp", "struct b { int x; };");
+    EXPECT_TRUE(w.instance->poll(std::chrono::seconds(10)));
+    EXPECT_EQ(w.parsed, names {"b.hpp"});
+
+    // No events: times out without an update
+    EXPECT_FALSE(w.instance->poll(std::chrono::milliseconds(50)));
+  }
+
+  TEST(WatcherTest, PollUpdatesWhileFilesKeepChanging) {
+    if (!xccmeta::watcher::is_supported()) GTEST_SKIP() << "No file events on this platform";
+
+    TempDirectory tmp;
+    tmp.write("a.hpp", "struct a {};");
+
+    xccmeta::watcher::config cfg;
+    cfg.inputs.patterns = {(tmp.path() / "*.hpp").generic_string()};
+    cfg.args = xccmeta::compile_args::modern_cxx();
+    cfg.debounce = std::chrono::milliseconds(200);
+    cfg.max_delay = std::chrono::milliseconds(300);
+    xccmeta::watcher w(cfg);
+    w.update();
+
+    // Rewritten more often than the debounce, so the events never settle
+    std::atomic<bool> done {false};
+    std::thread writer([&] {
+      for (int i = 0; !done; ++i) {
+        tmp.write("a.hpp", "struct a { int x" + std::to_string(i) + "; };");
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      }
+    });
+
+    const auto start = std::chrono::steady_clock::now();
+    const bool updated = w.poll(std::chrono::seconds(10));
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    done = true;
+    writer.join();
+
+    EXPECT_TRUE(updated);
+    EXPECT_LT(elapsed, std::chrono::seconds(5));
+  }
+
+  TEST(WatcherTest, LookupsDuringRun) {
+    TempDirectory tmp;
+    tmp.write("a.hpp", "struct a {};");
+
+    recorded_watcher w(tmp);
+    std::thread runner([&] { w.instance->run(); });
+
+    // Read concurrently with the updates of run()
+    const auto input = tmp.path() / "a.hpp";
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!w.instance->get_root(input) && std::chrono::steady_clock::now() < deadline) {
+      w.instance->get_dependencies(input);
+      std::this_thread::yield();
+    }
+    w.instance->stop();
+    runner.join();
+
+    EXPECT_NE(w.instance->get_root(input), nullptr);
+    EXPECT_EQ(w.parsed, names {"a.hpp"});
+  }
+
+  TEST(WatcherTest, StopEndsRun) {
+    TempDirectory tmp;
+    tmp.write("a.hpp", "struct a {};");
+
+    recorded_watcher w(tmp);
+    std::thread stopper([&] {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      w.instance->stop();
+    });
+
+    const auto start = std::chrono::steady_clock::now();
+    w.instance->run();
+    stopper.join();
+
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+    EXPECT_EQ(w.parsed, names {"a.hpp"});
+    EXPECT_FALSE(w.instance->poll(std::chrono::seconds(10)));  // Stays stopped
+  }
+
+}  // namespace